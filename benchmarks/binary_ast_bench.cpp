@@ -0,0 +1,122 @@
+// Binary AST load benchmark.
+//
+// Compares getting a usable tree by reparsing source (lex + parse) against
+// mapping a serialized AST and walking it in place. The mapped path
+// includes opening the file and validating the whole layout.
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "lexer.hpp"
+#include "parser/parser.h"
+#include "serialization/binary_ast.h"
+
+namespace {
+
+std::string syntheticProgram(int functions) {
+    std::stringstream ss;
+    for (int i = 0; i < functions; ++i) {
+        ss << "func f" << i << "(x, y) {\n"
+           << "    let t = x * " << i << " + (y - 3) / 2\n"
+           << "    let label = \"item\"\n"
+           << "    log(label, t)\n"
+           << "    return (t + x) * (y - 0xAF)\n"
+           << "}\n";
+    }
+    ss << "let result = f0(1, 2)\n";
+    return ss.str();
+}
+
+// Touch every node so both paths pay for a full traversal. Each node adds
+// one plus the length of its text, so both walks produce the same sum.
+uint64_t walk(novasyntax::BinaryAstNodeRef node) {
+    uint64_t sum = node.value().size() + 1;
+    for (uint32_t i = 0; i < node.childCount(); ++i) {
+        sum += walk(node.child(i));
+    }
+    return sum;
+}
+
+uint64_t walk(const novasyntax::ASTNode* node) {
+    if (!node) return 0;
+    if (auto* expr = dynamic_cast<const novasyntax::Expression*>(node)) {
+        uint64_t sum = expr->value.size() + 1;
+        sum += walk(expr->left.get()) + walk(expr->right.get());
+        for (const auto& argument : expr->arguments) sum += walk(argument.get());
+        return sum;
+    }
+    if (auto* var = dynamic_cast<const novasyntax::VariableDeclaration*>(node)) {
+        return var->name.size() + 1 + walk(var->initializer.get());
+    }
+    if (auto* func = dynamic_cast<const novasyntax::FunctionDeclaration*>(node)) {
+        uint64_t sum = func->name.size() + 1 + walk(func->body.get());
+        for (const auto& parameter : func->parameters) sum += parameter.size() + 1;
+        for (const auto& statement : func->statements) sum += walk(statement.get());
+        return sum;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kRuns = 5;
+    const std::string path = "novasyntax_bench.nsast";
+
+    std::cout << "NovaSyntax Binary AST Load Benchmark\n";
+    std::cout << "------------------------------------\n";
+    std::cout << std::setw(10) << "functions" << std::setw(12) << "source KB"
+              << std::setw(12) << "binary KB" << std::setw(14) << "reparse ms"
+              << std::setw(14) << "mmap ms" << std::setw(10) << "speedup" << "\n";
+
+    for (int functions : {1000, 10000, 50000}) {
+        std::string source = syntheticProgram(functions);
+        size_t binary_size = 0;
+        {
+            novasyntax::Lexer lexer(source);
+            novasyntax::Parser parser(lexer.tokenize(), false);
+            auto program = parser.parseProgram();
+            novasyntax::BinaryAstWriter writer;
+            binary_size = writer.serialize(program).size();
+            writer.writeFile(path, program);
+        }
+
+        double reparse_ms = 0;
+        double mapped_ms = 0;
+        uint64_t checksum = 0;
+        for (int run = 0; run < kRuns; ++run) {
+            auto start = Clock::now();
+            novasyntax::Lexer lexer(source);
+            novasyntax::Parser parser(lexer.tokenize(), false);
+            auto program = parser.parseProgram();
+            for (const auto& node : program) checksum += walk(node.get());
+            reparse_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            start = Clock::now();
+            novasyntax::MappedBinaryAst mapped(path);
+            const auto& view = mapped.view();
+            for (uint32_t i = 0; i < view.rootCount(); ++i) checksum -= walk(view.root(i));
+            mapped_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        if (checksum != 0) {
+            std::cerr << "Mapped tree does not match the parsed tree\n";
+            return 1;
+        }
+
+        reparse_ms /= kRuns;
+        mapped_ms /= kRuns;
+        std::cout << std::setw(10) << functions
+                  << std::setw(12) << source.size() / 1024
+                  << std::setw(12) << binary_size / 1024
+                  << std::setw(14) << std::fixed << std::setprecision(2) << reparse_ms
+                  << std::setw(14) << mapped_ms
+                  << std::setw(9) << std::setprecision(1) << reparse_ms / mapped_ms << "x\n";
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Embedding API throughput benchmark.
+//
+// Compiles one script, shares it between N threads that each own a
+// Context, and reports calls per second for each thread count. Heap
+// allocations are counted through the global operator new to show that
+// steady-state calls on numbers do not allocate.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <thread>
+#include "runtime/engine.h"
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+const char* kScript = R"(
+    func sq(v) { v * v }
+    func dist2(x1, y1, x2, y2) {
+        let dx = x2 - x1
+        let dy = y2 - y1
+        return sq(dx) + sq(dy)
+    }
+    func score(x, y) { dist2(x, y, origin_x, origin_y) / scale + 1 }
+    let origin_x = 3
+    let origin_y = 0 - 4
+    let scale = 0x10
+)";
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kCallsPerThread = 200000;
+
+    novasyntax::Engine engine;
+    std::shared_ptr<const novasyntax::Script> script = engine.compile(kScript, "score.nova");
+    const novasyntax::FunctionDeclaration* score = script->function("score");
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "NovaSyntax Engine Throughput Benchmark (" << cores << " hardware threads)\n";
+    std::cout << "--------------------------------------------------------\n";
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "calls/s"
+              << std::setw(10) << "scaling" << std::setw(16) << "allocs/call" << "\n";
+
+    std::vector<unsigned> thread_counts;
+    for (unsigned n = 1; n <= std::max(cores, 4u); n *= 2) thread_counts.push_back(n);
+
+    double single_thread_rate = 0;
+    for (unsigned n : thread_counts) {
+        std::atomic<bool> start{false};
+        std::atomic<unsigned> ready{0};
+        std::vector<double> sums(n, 0);
+        std::vector<std::thread> threads;
+        uint64_t allocations = 0;
+
+        for (unsigned t = 0; t < n; ++t) {
+            threads.emplace_back([&, t] {
+                novasyntax::Context context;
+                // Warm-up call, so the context reaches its working size
+                double sum = std::get<double>(context.call(*script, *score, {1.0, 2.0}));
+                ready++;
+                while (!start.load()) std::this_thread::yield();
+                for (int i = 0; i < kCallsPerThread; ++i) {
+                    sum += std::get<double>(context.call(*script, *score, {i * 0.5, double(t)}));
+                }
+                // Written once, so neighbouring sums do not share a hot cache line
+                sums[t] = sum;
+            });
+        }
+        while (ready.load() < n) std::this_thread::yield();
+
+        uint64_t allocations_before = g_allocations.load();
+        auto begin = Clock::now();
+        start = true;
+        for (auto& thread : threads) thread.join();
+        double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+        allocations = g_allocations.load() - allocations_before;
+
+        double rate = n * double(kCallsPerThread) / seconds;
+        if (n == 1) single_thread_rate = rate;
+        std::cout << std::setw(8) << n << std::setw(16) << std::fixed << std::setprecision(0) << rate
+                  << std::setw(9) << std::setprecision(2) << rate / single_thread_rate << "x"
+                  << std::setw(16) << std::setprecision(3) << double(allocations) / (n * double(kCallsPerThread))
+                  << "\n";
+    }
+
+    return 0;
+}
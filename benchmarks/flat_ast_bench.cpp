@@ -0,0 +1,298 @@
+// AST traversal benchmark.
+//
+// Runs the same three analyses (node counts per kind, constant folding and
+// expression height) over a large program three ways:
+//   dynamic_cast   one recursive walk per pass, dispatching with casts
+//   visitor        one AstVisitor (CRTP) walk per pass
+//   fused flat     all passes in a single runFusedPasses sweep over FlatAst
+// Building the FlatAst is timed separately, since it is paid once per tree.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include "lexer.hpp"
+#include "parser/ast_visitor.h"
+#include "parser/flat_ast.h"
+
+namespace {
+
+using namespace novasyntax;
+
+std::string syntheticProgram(int functions) {
+    std::stringstream ss;
+    for (int i = 0; i < functions; ++i) {
+        ss << "func f" << i << "(x, y) {\n"
+           << "    let t = x * " << i << " + (y - 3) / 2\n"
+           << "    let k = (1 + 2) * (3 - " << i % 7 << ")\n"
+           << "    log(t, k * 2)\n"
+           << "    return (t + x) * (y - 0xAF) + k\n"
+           << "}\n";
+    }
+    return ss.str();
+}
+
+std::optional<double> applyOperator(TokenType op, double left, double right) {
+    switch (op) {
+        case TokenType::PLUS: return left + right;
+        case TokenType::MINUS: return left - right;
+        case TokenType::MULTIPLY: return left * right;
+        default: return left / right;
+    }
+}
+
+struct Results {
+    uint64_t counts[3] = {};
+    uint64_t folded = 0;
+    double folded_sum = 0;
+    int height = 0;
+
+    bool operator==(const Results& other) const {
+        return std::equal(counts, counts + 3, other.counts) && folded == other.folded &&
+               folded_sum == other.folded_sum && height == other.height;
+    }
+};
+
+// --- dynamic_cast passes ----------------------------------------------------
+
+void castCount(const ASTNode* node, Results& r) {
+    if (auto* expr = dynamic_cast<const Expression*>(node)) {
+        r.counts[0]++;
+        if (expr->left) castCount(expr->left.get(), r);
+        if (expr->right) castCount(expr->right.get(), r);
+        for (const auto& argument : expr->arguments) castCount(argument.get(), r);
+    } else if (auto* var = dynamic_cast<const VariableDeclaration*>(node)) {
+        r.counts[1]++;
+        if (var->initializer) castCount(var->initializer.get(), r);
+    } else if (auto* func = dynamic_cast<const FunctionDeclaration*>(node)) {
+        r.counts[2]++;
+        for (const auto& statement : func->statements) castCount(statement.get(), r);
+        if (func->body) castCount(func->body.get(), r);
+    }
+}
+
+std::optional<double> castFold(const ASTNode* node, Results& r) {
+    if (auto* expr = dynamic_cast<const Expression*>(node)) {
+        if (expr->type == Expression::Type::LITERAL) return std::strtod(expr->value.c_str(), nullptr);
+        if (expr->type == Expression::Type::BINARY) {
+            auto left = castFold(expr->left.get(), r);
+            auto right = castFold(expr->right.get(), r);
+            if (!left || !right) return std::nullopt;
+            auto result = applyOperator(expr->op, *left, *right);
+            r.folded++;
+            r.folded_sum += *result;
+            return result;
+        }
+        for (const auto& argument : expr->arguments) castFold(argument.get(), r);
+    } else if (auto* var = dynamic_cast<const VariableDeclaration*>(node)) {
+        castFold(var->initializer.get(), r);
+    } else if (auto* func = dynamic_cast<const FunctionDeclaration*>(node)) {
+        for (const auto& statement : func->statements) castFold(statement.get(), r);
+        castFold(func->body.get(), r);
+    }
+    return std::nullopt;
+}
+
+int castHeight(const ASTNode* node) {
+    int height = 0;
+    if (auto* expr = dynamic_cast<const Expression*>(node)) {
+        if (expr->left) height = std::max(height, castHeight(expr->left.get()));
+        if (expr->right) height = std::max(height, castHeight(expr->right.get()));
+        for (const auto& argument : expr->arguments) height = std::max(height, castHeight(argument.get()));
+    } else if (auto* var = dynamic_cast<const VariableDeclaration*>(node)) {
+        if (var->initializer) height = castHeight(var->initializer.get());
+    } else if (auto* func = dynamic_cast<const FunctionDeclaration*>(node)) {
+        for (const auto& statement : func->statements) height = std::max(height, castHeight(statement.get()));
+        if (func->body) height = std::max(height, castHeight(func->body.get()));
+    }
+    return height + 1;
+}
+
+// --- AstVisitor passes ------------------------------------------------------
+
+struct VisitorCount : AstVisitor<VisitorCount> {
+    Results& r;
+    explicit VisitorCount(Results& results) : r(results) {}
+
+    void visitExpression(const Expression& expr) { r.counts[0]++; visitChildren(expr); }
+    void visitVariable(const VariableDeclaration& var) { r.counts[1]++; visitChildren(var); }
+    void visitFunction(const FunctionDeclaration& func) { r.counts[2]++; visitChildren(func); }
+};
+
+struct VisitorFold : AstVisitor<VisitorFold, std::optional<double>> {
+    Results& r;
+    explicit VisitorFold(Results& results) : r(results) {}
+
+    std::optional<double> visitExpression(const Expression& expr) {
+        if (expr.type == Expression::Type::LITERAL) return std::strtod(expr.value.c_str(), nullptr);
+        if (expr.type == Expression::Type::BINARY) {
+            auto left = visit(*expr.left);
+            auto right = visit(*expr.right);
+            if (!left || !right) return std::nullopt;
+            auto result = applyOperator(expr.op, *left, *right);
+            r.folded++;
+            r.folded_sum += *result;
+            return result;
+        }
+        visitChildren(expr);
+        return std::nullopt;
+    }
+};
+
+struct VisitorHeight : AstVisitor<VisitorHeight, int> {
+    int visitExpression(const Expression& expr) {
+        int height = 0;
+        if (expr.left) height = std::max(height, visit(*expr.left));
+        if (expr.right) height = std::max(height, visit(*expr.right));
+        for (const auto& argument : expr.arguments) height = std::max(height, visit(*argument));
+        return height + 1;
+    }
+    int visitVariable(const VariableDeclaration& var) {
+        return (var.initializer ? visit(*var.initializer) : 0) + 1;
+    }
+    int visitFunction(const FunctionDeclaration& func) {
+        int height = 0;
+        for (const auto& statement : func.statements) height = std::max(height, visit(*statement));
+        if (func.body) height = std::max(height, visit(*func.body));
+        return height + 1;
+    }
+};
+
+// --- Fused flat passes ------------------------------------------------------
+
+struct FlatCount {
+    Results& r;
+
+    void visit(const FlatNode& node, uint32_t) {
+        switch (node.kind) {
+            case FlatNodeKind::PARAMETER: break;
+            case FlatNodeKind::VARIABLE: r.counts[1]++; break;
+            case FlatNodeKind::FUNCTION: r.counts[2]++; break;
+            default: r.counts[0]++; break;
+        }
+    }
+};
+
+struct FlatFold {
+    Results& r;
+    std::vector<std::optional<double>> values;
+
+    void visit(const FlatNode& node, uint32_t) {
+        if (node.kind == FlatNodeKind::NUMBER) {
+            values.push_back(std::strtod(node.value.data(), nullptr));
+            return;
+        }
+        if (node.kind == FlatNodeKind::BINARY) {
+            auto right = values.back();
+            values.pop_back();
+            auto& left = values.back();
+            if (left && right) {
+                left = applyOperator(static_cast<novasyntax::TokenType>(node.op), *left, *right);
+                r.folded++;
+                r.folded_sum += *left;
+            } else {
+                left = std::nullopt;
+            }
+            return;
+        }
+        values.resize(values.size() - node.child_count);
+        values.push_back(std::nullopt);
+    }
+};
+
+struct FlatHeight {
+    Results& r;
+    std::vector<int> heights;
+
+    void visit(const FlatNode& node, uint32_t) {
+        if (node.kind == FlatNodeKind::PARAMETER) {
+            heights.push_back(-1);  // Not counted by the tree passes
+            return;
+        }
+        int height = 0;
+        for (uint32_t i = 0; i < node.child_count; ++i) {
+            height = std::max(height, heights.back());
+            heights.pop_back();
+        }
+        heights.push_back(height + 1);
+        r.height = std::max(r.height, height + 1);
+    }
+};
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    constexpr int kRuns = 5;
+
+    std::cout << "NovaSyntax AST Traversal Benchmark (3 passes)\n";
+    std::cout << "---------------------------------------------\n";
+    std::cout << std::setw(10) << "functions" << std::setw(10) << "nodes"
+              << std::setw(16) << "dynamic_cast ms" << std::setw(13) << "visitor ms"
+              << std::setw(15) << "flat build ms" << std::setw(15) << "fused walk ms" << "\n";
+
+    for (int functions : {1000, 10000, 100000}) {
+        std::string source = syntheticProgram(functions);
+        Lexer lexer(source);
+        Parser parser(lexer.tokenize(), false);
+        auto program = parser.parseProgram();
+
+        FlatAst flat;
+        double cast_ms = 0, visitor_ms = 0, build_ms = 0, fused_ms = 0;
+        Results cast_results, visitor_results, flat_results;
+
+        for (int run = 0; run < kRuns; ++run) {
+            cast_results = Results{};
+            cast_ms += timeMs([&] {
+                for (const auto& node : program) castCount(node.get(), cast_results);
+                for (const auto& node : program) castFold(node.get(), cast_results);
+                for (const auto& node : program) {
+                    cast_results.height = std::max(cast_results.height, castHeight(node.get()));
+                }
+            });
+
+            visitor_results = Results{};
+            visitor_ms += timeMs([&] {
+                VisitorCount count(visitor_results);
+                count.visitProgram(program);
+                VisitorFold fold(visitor_results);
+                fold.visitProgram(program);
+                VisitorHeight height;
+                for (const auto& node : program) {
+                    visitor_results.height = std::max(visitor_results.height, height.visit(*node));
+                }
+            });
+
+            build_ms += timeMs([&] { flat.build(program); });
+
+            flat_results = Results{};
+            fused_ms += timeMs([&] {
+                FlatCount count{flat_results};
+                FlatFold fold{flat_results, {}};
+                FlatHeight height{flat_results, {}};
+                runFusedPasses(flat, count, fold, height);
+            });
+        }
+
+        if (!(cast_results == visitor_results) || !(cast_results == flat_results)) {
+            std::cerr << "Traversals disagree\n";
+            return 1;
+        }
+
+        std::cout << std::setw(10) << functions << std::setw(10) << flat.size()
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(16) << cast_ms / kRuns << std::setw(13) << visitor_ms / kRuns
+                  << std::setw(15) << build_ms / kRuns << std::setw(15) << fused_ms / kRuns << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Formatter throughput benchmark.
+//
+// Simulates a pre-commit hook over many files: each synthetic file is
+// lexed, parsed and formatted with one shared Formatter. Reports MB/s of
+// input for the whole pipeline and for the printing step alone.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "format/formatter.h"
+#include "lexer.hpp"
+#include "parser/parser.h"
+
+namespace {
+
+// Deliberately unformatted input so the formatter has work to do
+std::string syntheticFile(int seed, int functions) {
+    std::stringstream ss;
+    ss << "let  scale" << seed << "=" << seed << ".5e-2\n";
+    for (int i = 0; i < functions; ++i) {
+        ss << "func  f" << i << "( x,y ){\n"
+           << "  let t=x*scale" << seed << "+(y-" << i << ")/2\n"
+           << "  let label =  \"item " << i << "\"\n"
+           << "  log(label,t)\n"
+           << "      return (t+x)*(y - 0xAF)\n"
+           << "}\n";
+    }
+    ss << "let result=f0(1,2)\n";
+    return ss.str();
+}
+
+} // namespace
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kFiles = 2000;
+    constexpr int kFunctionsPerFile = 40;
+
+    std::vector<std::string> files;
+    size_t total_bytes = 0;
+    for (int i = 0; i < kFiles; ++i) {
+        files.push_back(syntheticFile(i, kFunctionsPerFile));
+        total_bytes += files.back().size();
+    }
+
+    novasyntax::Formatter formatter;
+    size_t output_bytes = 0;
+    double format_seconds = 0;
+
+    auto start = Clock::now();
+    for (const auto& source : files) {
+        novasyntax::Lexer lexer(source);
+        novasyntax::Parser parser(lexer.tokenize(), false);
+        auto program = parser.parseProgram();
+        if (parser.hadError()) {
+            std::cerr << "Unexpected parse error in synthetic file\n";
+            return 1;
+        }
+
+        auto format_start = Clock::now();
+        output_bytes += formatter.format(program).size();
+        format_seconds += std::chrono::duration<double>(Clock::now() - format_start).count();
+    }
+    double total_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double megabytes = static_cast<double>(total_bytes) / (1024.0 * 1024.0);
+    std::cout << "NovaSyntax Formatter Benchmark\n";
+    std::cout << "------------------------------\n";
+    std::cout << "Files:               " << kFiles << "\n";
+    std::cout << "Input:               " << std::fixed << std::setprecision(2) << megabytes << " MB\n";
+    std::cout << "Output:              " << static_cast<double>(output_bytes) / (1024.0 * 1024.0) << " MB\n";
+    std::cout << "Lex+parse+format:    " << megabytes / total_seconds << " MB/s\n";
+    std::cout << "Format only:         " << megabytes / format_seconds << " MB/s\n";
+    return 0;
+}
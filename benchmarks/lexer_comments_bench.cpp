@@ -0,0 +1,85 @@
+// Comment handling benchmark.
+//
+// Lexes heavily commented source in both comment modes and the same code
+// with the comments removed. SKIP finds the end of each comment with
+// memchr; PRESERVE does the same scan and also records a Trivia entry per
+// comment.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "lexer.hpp"
+
+namespace {
+
+std::string syntheticProgram(int functions, bool with_comments) {
+    std::stringstream ss;
+    for (int i = 0; i < functions; ++i) {
+        if (with_comments) {
+            ss << "// ------------------------------------------------------------------\n"
+               << "// f" << i << ": scales and offsets its inputs. Kept deliberately long so\n"
+               << "// that comments dominate the file, as in documented library code.\n"
+               << "/* Parameters:\n"
+               << " *   x - first operand\n"
+               << " *   y - second operand\n"
+               << " */\n";
+        }
+        ss << "func f" << i << "(x, y) {";
+        if (with_comments) ss << " // body";
+        ss << "\n    let t = x * " << i << " + (y - 3) / 2";
+        if (with_comments) ss << " // intermediate value used below";
+        ss << "\n    return t + x";
+        if (with_comments) ss << " /* result */";
+        ss << "\n}\n";
+    }
+    return ss.str();
+}
+
+struct Result {
+    double ms;
+    size_t tokens;
+    size_t trivia;
+};
+
+Result lex(const std::string& source, novasyntax::CommentMode mode, int runs) {
+    Result result{0, 0, 0};
+    for (int run = 0; run < runs; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        novasyntax::Lexer lexer(source, mode);
+        auto tokens = lexer.tokenize();
+        result.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        result.tokens = tokens.size();
+        result.trivia = lexer.trivia().size();
+    }
+    result.ms /= runs;
+    return result;
+}
+
+} // namespace
+
+int main() {
+    constexpr int kFunctions = 20000;
+    constexpr int kRuns = 5;
+
+    std::string commented = syntheticProgram(kFunctions, true);
+    std::string plain = syntheticProgram(kFunctions, false);
+
+    std::cout << "NovaSyntax Lexer Comment Benchmark\n";
+    std::cout << "----------------------------------\n";
+    std::cout << "Commented source: " << commented.size() / 1024 << " KB ("
+              << 100 * (commented.size() - plain.size()) / commented.size() << "% comments)\n\n";
+    std::cout << std::setw(22) << "input / mode" << std::setw(10) << "ms" << std::setw(10) << "MB/s"
+              << std::setw(10) << "tokens" << std::setw(10) << "trivia" << "\n";
+
+    auto report = [](const char* label, const std::string& source, const Result& r) {
+        std::cout << std::setw(22) << label << std::fixed << std::setprecision(2) << std::setw(10) << r.ms
+                  << std::setw(10) << std::setprecision(1) << source.size() / (r.ms * 1000.0)
+                  << std::setw(10) << r.tokens << std::setw(10) << r.trivia << "\n";
+    };
+
+    report("commented / skip", commented, lex(commented, novasyntax::CommentMode::SKIP, kRuns));
+    report("commented / preserve", commented, lex(commented, novasyntax::CommentMode::PRESERVE, kRuns));
+    report("uncommented", plain, lex(plain, novasyntax::CommentMode::SKIP, kRuns));
+    return 0;
+}
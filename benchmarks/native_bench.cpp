@@ -0,0 +1,137 @@
+// Native backend benchmark.
+//
+// Builds a set of numeric scripts with the C backend (`novasyntax build`'s
+// pipeline), then calls each function many times through the tree-walking
+// interpreter and through the loaded shared object.
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include "codegen/c_backend.h"
+#include "lexer.hpp"
+#include "runtime/interpreter.h"
+#include "semantic/type_inference.h"
+
+namespace {
+
+struct Script {
+    const char* name;
+    const char* function;
+    const char* source;
+};
+
+const Script kScripts[] = {
+    {"polynomial", "poly", R"(
+        func poly(x) { return 3.5 * x * x * x - 2 * x * x + x / 4 - 0xAF }
+    )"},
+    {"distance", "dist2", R"(
+        func sq(v) { v * v }
+        func dist2(x1, y1, x2, y2) {
+            let dx = x2 - x1
+            let dy = y2 - y1
+            return sq(dx) + sq(dy)
+        }
+    )"},
+    {"kinematics", "position", R"(
+        func velocity(v0, a, t) { v0 + a * t }
+        func position(x0, v0, a, t) {
+            let half = 0.5 * a * t * t
+            return x0 + v0 * t + half + velocity(v0, a, t) * 0
+        }
+    )"},
+    {"horner", "horner", R"(
+        func horner(x) {
+            let r = 0b1011
+            let r = r * x + 42.5e-2
+            let r = r * x - 3
+            let r = r * x + 7
+            let r = r * x - 1
+            return r * x + 0.125
+        }
+    )"},
+};
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    constexpr int kCalls = 200000;
+    const std::string c_path = "novasyntax_native_bench.c";
+    const std::string so_path = "novasyntax_native_bench.so";
+
+    std::cout << "NovaSyntax Native vs Interpreted Benchmark (" << kCalls << " calls each)\n";
+    std::cout << "-------------------------------------------------------------\n";
+    std::cout << std::setw(12) << "script" << std::setw(12) << "build ms"
+              << std::setw(16) << "interpreted ms" << std::setw(12) << "native ms"
+              << std::setw(10) << "speedup" << "\n";
+
+    for (const Script& script : kScripts) {
+        novasyntax::Lexer lexer(script.source);
+        novasyntax::Parser parser(lexer.tokenize(), false);
+        auto program = parser.parseProgram();
+        novasyntax::TypeInference inference;
+        if (parser.hadError() || !inference.run(program).empty()) {
+            std::cerr << script.name << ": script does not compile\n";
+            return 1;
+        }
+
+        std::string error;
+        novasyntax::CBackend backend;
+        double build_ms = timeMs([&] {
+            std::ofstream(c_path) << backend.emit(program, script.name);
+            if (!novasyntax::compileSharedObject(c_path, so_path, error)) {
+                std::cerr << script.name << ": " << error << "\n";
+            }
+        });
+        if (!error.empty()) return 1;
+
+        novasyntax::NativeModule module(so_path);
+        const novasyntax::NativeFunction* native = module.function(script.function);
+        if (!native) {
+            std::cerr << script.name << ": '" << script.function << "' was not lowered\n";
+            return 1;
+        }
+
+        novasyntax::Interpreter interpreter(program);
+        std::vector<novasyntax::Value> arguments(native->arity);
+        double native_arguments[novasyntax::kMaxNativeArity] = {};
+
+        double interpreted_sum = 0;
+        double interpreted_ms = timeMs([&] {
+            for (int i = 0; i < kCalls; ++i) {
+                for (size_t a = 0; a < arguments.size(); ++a) arguments[a] = i * 0.001 + a;
+                interpreted_sum += std::get<double>(interpreter.call(script.function, arguments));
+            }
+        });
+
+        double native_sum = 0;
+        double native_ms = timeMs([&] {
+            for (int i = 0; i < kCalls; ++i) {
+                for (size_t a = 0; a < native->arity; ++a) native_arguments[a] = i * 0.001 + a;
+                native_sum += native->call(native_arguments);
+            }
+        });
+
+        if (interpreted_sum != native_sum) {
+            std::cerr << script.name << ": native and interpreted results differ\n";
+            return 1;
+        }
+
+        std::cout << std::setw(12) << script.name << std::fixed << std::setprecision(1)
+                  << std::setw(12) << build_ms << std::setw(16) << interpreted_ms
+                  << std::setw(12) << std::setprecision(2) << native_ms
+                  << std::setw(9) << std::setprecision(0) << interpreted_ms / native_ms << "x\n";
+    }
+
+    std::remove(c_path.c_str());
+    std::remove(so_path.c_str());
+    return 0;
+}
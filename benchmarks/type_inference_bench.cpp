@@ -0,0 +1,98 @@
+// Type inference scaling benchmark.
+//
+// Generates synthetic programs of increasing size (chains of functions that
+// call their predecessor, mixing number and string arithmetic), then times
+// lexing+parsing and the inference pass separately. Near-linear inference
+// shows up as a roughly constant ns/node column.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "lexer.hpp"
+#include "parser/parser.h"
+#include "semantic/type_inference.h"
+
+namespace {
+
+std::string syntheticProgram(int functions) {
+    std::stringstream ss;
+    ss << "func f0(a, b) { a * b + 1 }\n";
+    ss << "func s0(p, q) { p + q }\n";
+    for (int i = 1; i < functions; ++i) {
+        ss << "func f" << i << "(x, y) {\n"
+           << "    let t = f" << (i - 1) << "(x, y) * 2\n"
+           << "    let u = (t - x) / (y + 3)\n"
+           << "    return t + u * x\n"
+           << "}\n"
+           << "func s" << i << "(p, q) {\n"
+           << "    let label = s" << (i - 1) << "(p, \"-\")\n"
+           << "    return label + q\n"
+           << "}\n";
+    }
+    ss << "let total = f" << (functions - 1) << "(1, 2)\n";
+    ss << "let name = s" << (functions - 1) << "(\"a\", \"b\")\n";
+    return ss.str();
+}
+
+size_t countNodes(const novasyntax::ASTNode* node) {
+    if (!node) return 0;
+    if (auto* expr = dynamic_cast<const novasyntax::Expression*>(node)) {
+        size_t count = 1 + countNodes(expr->left.get()) + countNodes(expr->right.get());
+        for (const auto& argument : expr->arguments) count += countNodes(argument.get());
+        return count;
+    }
+    if (auto* decl = dynamic_cast<const novasyntax::VariableDeclaration*>(node)) {
+        return 1 + countNodes(decl->initializer.get());
+    }
+    if (auto* func = dynamic_cast<const novasyntax::FunctionDeclaration*>(node)) {
+        size_t count = 1 + countNodes(func->body.get());
+        for (const auto& statement : func->statements) count += countNodes(statement.get());
+        return count;
+    }
+    return 1;
+}
+
+} // namespace
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+
+    std::cout << "NovaSyntax Type Inference Benchmark\n";
+    std::cout << "-----------------------------------\n";
+    std::cout << std::setw(10) << "functions" << std::setw(12) << "nodes"
+              << std::setw(14) << "parse ms" << std::setw(14) << "infer ms"
+              << std::setw(14) << "ns/node" << "\n";
+
+    for (int functions : {1000, 10000, 50000, 100000}) {
+        std::string source = syntheticProgram(functions);
+
+        auto parse_start = Clock::now();
+        novasyntax::Lexer lexer(source);
+        novasyntax::Parser parser(lexer.tokenize(), false);
+        auto program = parser.parseProgram();
+        auto parse_end = Clock::now();
+
+        size_t nodes = 0;
+        for (const auto& node : program) nodes += countNodes(node.get());
+
+        novasyntax::TypeInference inference;
+        auto infer_start = Clock::now();
+        auto diagnostics = inference.run(program);
+        auto infer_end = Clock::now();
+
+        if (parser.hadError() || !diagnostics.empty()) {
+            std::cerr << "Unexpected errors in synthetic program\n";
+            return 1;
+        }
+
+        double parse_ms = std::chrono::duration<double, std::milli>(parse_end - parse_start).count();
+        double infer_ms = std::chrono::duration<double, std::milli>(infer_end - infer_start).count();
+        std::cout << std::setw(10) << functions << std::setw(12) << nodes
+                  << std::setw(14) << std::fixed << std::setprecision(2) << parse_ms
+                  << std::setw(14) << infer_ms
+                  << std::setw(14) << (infer_ms * 1e6 / static_cast<double>(nodes)) << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../parser/parser.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace novasyntax {
+
+// Functions with more parameters are not lowered
+constexpr size_t kMaxNativeArity = 8;
+
+struct LoweredFunction {
+    std::string name;
+    size_t arity;
+};
+
+struct SkippedFunction {
+    std::string name;
+    std::string reason;
+    int line;
+};
+
+// Lowers numeric FunctionDeclarations to portable C (C99, no headers).
+//
+// A function is lowered when it returns a number, has at most
+// kMaxNativeArity parameters and its body only uses number literals,
+// arithmetic, its own parameters and 'let's, and calls to other lowered
+// functions. Parameters left generic by type inference are specialized to
+// numbers. Every lowered function `f` becomes `double ns_f(double...)`,
+// and the exported table `novasyntax_exports` lists names and arities.
+// Everything else is reported through skipped() and stays interpreted.
+//
+// Run TypeInference on the program first; emit() relies on its
+// return and parameter types.
+class CBackend {
+public:
+    // Returns the C translation unit. `source_name` goes into the header
+    // comment only, with any '*/' in it broken up.
+    const std::string& emit(const std::vector<std::unique_ptr<ASTNode>>& program,
+                            const std::string& source_name = "");
+
+    const std::vector<LoweredFunction>& lowered() const { return lowered_; }
+    const std::vector<SkippedFunction>& skipped() const { return skipped_; }
+
+private:
+    std::string out_;
+    std::vector<LoweredFunction> lowered_;
+    std::vector<SkippedFunction> skipped_;
+};
+
+// Compile a C file into a shared object with the system compiler ($CC,
+// or `cc`). Compiler diagnostics go to stderr. Returns false and sets
+// `error` on failure.
+bool compileSharedObject(const std::string& c_path, const std::string& so_path, std::string& error);
+
+struct NativeFunction {
+    std::string name;
+    size_t arity;
+    void* address;
+
+    // `arguments` must hold `arity` values
+    double call(const double* arguments) const;
+};
+
+// A shared object produced by CBackend + compileSharedObject, loaded with
+// dlopen. Throws std::runtime_error if it cannot be loaded or was not
+// built by the backend.
+class NativeModule {
+public:
+    explicit NativeModule(const std::string& path);
+    ~NativeModule();
+
+    NativeModule(const NativeModule&) = delete;
+    NativeModule& operator=(const NativeModule&) = delete;
+
+    // nullptr if the module has no such function
+    const NativeFunction* function(const std::string& name) const;
+    const std::vector<NativeFunction>& functions() const { return functions_; }
+
+private:
+    void* handle_ = nullptr;
+    std::vector<NativeFunction> functions_;
+};
+
+} // namespace novasyntax
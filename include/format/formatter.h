@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../lexer.hpp"
+#include "../parser/parser.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace novasyntax {
+
+struct FormatOptions {
+    int indent_width = 4;
+};
+
+// Comments to carry over into the output: the source, and the tokens and
+// trivia of a Lexer run in CommentMode::PRESERVE over it
+struct SourceComments {
+    const std::string& source;
+    const std::vector<Token>& tokens;
+    const std::vector<Trivia>& trivia;
+};
+
+// Prints an AST back as canonical NovaSyntax source.
+//
+// All output goes into one growable buffer owned by the formatter; it is
+// cleared, not released, between calls, so formatting many files reuses
+// the same allocation. Canonical form:
+//   - one statement per line, bodies indented by indent_width spaces
+//   - the result expression of a function is written as 'return <expr>'
+//   - a blank line around every top-level function
+//   - single spaces around binary operators and after commas
+//   - parentheses only where precedence or associativity requires them
+//   - comments on their own line stay on their own line, before the
+//     statement that followed them; comments after code on the same line
+//     stay at the end of that statement's line, up to the first '//' or
+//     multi-line comment there, which ends it
+//   - a blank line after a comment at the start of the file is kept
+// Formatting the output again yields the same text.
+class Formatter {
+public:
+    explicit Formatter(FormatOptions options = {});
+
+    // Format a parsed program, re-emitting `comments` if given. The
+    // returned buffer stays valid until the next call.
+    const std::string& format(const std::vector<std::unique_ptr<ASTNode>>& program,
+                              const SourceComments* comments = nullptr);
+
+    // Lex, parse and format source text, keeping its comments. Returns
+    // false without touching `out` if the source does not parse; `error`
+    // then describes why.
+    bool formatSource(const std::string& source, std::string& out, std::string& error);
+
+private:
+    FormatOptions options_;
+    std::string out_;
+    const SourceComments* comments_ = nullptr;
+    size_t next_comment_ = 0;
+    size_t closed_line_ = std::string::npos;  // End of a line a comment closed
+
+    // Emit the comments that come before a source position
+    bool hasCommentBefore(int line, int column) const;
+    bool blankLineAfter(const Trivia& comment) const;
+    void flushTrailingComments(int line, int column);
+    void flushComments(int line, int column, int depth);
+    void writeComment(const Trivia& comment);
+    void closingBrace(const FunctionDeclaration& func, int& line, int& column) const;
+
+    void writeTopLevel(const ASTNode& node);
+    void writeFunction(const FunctionDeclaration& func);
+    void writeVariable(const VariableDeclaration& var, int depth);
+    void writeStatement(const ASTNode& node, int depth);
+    void writeNode(const ASTNode* node);
+    void writeExpression(const Expression& expr);
+    void writeOperand(const Expression* operand, int parent_precedence, bool right_side);
+    void writeIndent(int depth);
+};
+
+} // namespace novasyntax
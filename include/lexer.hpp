@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <variant>
@@ -45,22 +46,48 @@ struct Token {
     int column;
 };
 
+// What the lexer does with '//' line and '/* */' block comments
+enum class CommentMode {
+    SKIP,      // Drop them
+    PRESERVE   // Also record them in Lexer::trivia()
+};
+
+// A comment recorded in CommentMode::PRESERVE. Comments are kept in a
+// side table next to the token stream and refer to tokens by index.
+struct Trivia {
+    size_t begin;    // Byte range in the source, including the markers
+    size_t end;
+    int line;
+    int column;
+    size_t token;    // Index of the token the comment belongs to
+    bool trailing;   // After `token` on the same line; otherwise it
+                     // precedes `token` (the EOF token at end of input)
+};
+
 class Lexer {
 public:
-    Lexer(const std::string& source);
+    Lexer(const std::string& source, CommentMode comments = CommentMode::SKIP);
     std::vector<Token> tokenize();
 
+    // Comments in source order, filled by tokenize() in PRESERVE mode
+    const std::vector<Trivia>& trivia() const { return comment_trivia; }
+
 private:
     std::string source;
     size_t current;
     size_t start;
     int line;
     int column;
+    CommentMode comment_mode;
+    std::vector<Trivia> comment_trivia;
 
     char advance();
     char peek();
     bool isAtEnd();
-    void skipWhitespace();
+    // Skips whitespace and comments; `next_token` is the index of the
+    // token that follows them
+    void skipWhitespace(size_t next_token);
+    void skipComment(size_t next_token, bool trailing);
     Token createToken(TokenType type);
     Token identifierToken();
     Token numberToken();
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace novasyntax::lsp {
+
+// Semantic token types, in legend order
+enum class SemanticTokenType : uint32_t {
+    KEYWORD,
+    FUNCTION,
+    PARAMETER,
+    VARIABLE,
+    NUMBER,
+    STRING,
+    OPERATOR
+};
+
+// Bit in the token modifier set for identifiers that declare a name
+constexpr uint32_t kDeclarationModifier = 1;
+
+const std::vector<std::string>& semanticTokenTypes();
+const std::vector<std::string>& semanticTokenModifiers();
+
+// All positions below are 0-based, as in the protocol
+struct Diagnostic {
+    int line;
+    int column;
+    int length;
+    std::string message;
+};
+
+// One identifier occurrence and what it resolves to
+struct Symbol {
+    int line;
+    int column;
+    int length;
+    SemanticTokenType kind;
+    int definition;  // Index of the declaring Symbol, itself for declarations, -1 if unresolved
+};
+
+struct DocumentAnalysis {
+    int version = 0;
+    std::vector<Diagnostic> diagnostics;
+    std::vector<Symbol> symbols;           // In source order
+    std::vector<uint32_t> semantic_tokens; // Relative (delta) encoded, five integers per token
+};
+
+// Lex, parse and type check a document. Checks `cancelled` between phases
+// and returns false as soon as it is set; `out` is then incomplete.
+bool analyzeDocument(const std::string& text, const std::atomic<bool>& cancelled, DocumentAnalysis& out);
+
+// Index of the symbol covering a position, or -1
+int symbolAt(const DocumentAnalysis& analysis, int line, int column);
+
+} // namespace novasyntax::lsp
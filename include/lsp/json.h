@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace novasyntax::lsp {
+
+// Minimal JSON value for the language server protocol. Objects keep their
+// members in insertion order; lookups are linear, which is fine for the
+// handful of keys an LSP message carries.
+class Json {
+public:
+    using Array = std::vector<Json>;
+    using Object = std::vector<std::pair<std::string, Json>>;
+
+    Json() : value_(nullptr) {}
+    Json(std::nullptr_t) : value_(nullptr) {}
+    Json(bool value) : value_(value) {}
+    Json(int value) : value_(static_cast<double>(value)) {}
+    Json(long value) : value_(static_cast<double>(value)) {}
+    Json(long long value) : value_(static_cast<double>(value)) {}
+    Json(unsigned long value) : value_(static_cast<double>(value)) {}
+    Json(unsigned long long value) : value_(static_cast<double>(value)) {}
+    Json(double value) : value_(value) {}
+    Json(const char* value) : value_(std::string(value)) {}
+    Json(std::string value) : value_(std::move(value)) {}
+    Json(Array value) : value_(std::move(value)) {}
+    Json(Object value) : value_(std::move(value)) {}
+
+    // Throws std::runtime_error on malformed input
+    static Json parse(std::string_view text);
+
+    std::string dump() const;
+    void dump(std::string& out) const;
+
+    bool isNull() const { return std::holds_alternative<std::nullptr_t>(value_); }
+    bool isBool() const { return std::holds_alternative<bool>(value_); }
+    bool isNumber() const { return std::holds_alternative<double>(value_); }
+    bool isString() const { return std::holds_alternative<std::string>(value_); }
+    bool isArray() const { return std::holds_alternative<Array>(value_); }
+    bool isObject() const { return std::holds_alternative<Object>(value_); }
+
+    // Typed accessors return the fallback when the value has another type
+    bool asBool(bool fallback = false) const;
+    double asNumber(double fallback = 0) const;
+    int asInt(int fallback = 0) const;   // Also the fallback outside int range
+    const std::string& asString() const;
+    const Array& asArray() const;
+    const Object& asObject() const;
+
+    // Member lookup; yields a null value for missing keys or non-objects
+    const Json& operator[](std::string_view key) const;
+    bool contains(std::string_view key) const;
+
+    // Appends a member, turning a null value into an object first
+    Json& set(std::string key, Json value);
+    // Appends an element, turning a null value into an array first
+    Json& push(Json value);
+
+private:
+    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> value_;
+};
+
+} // namespace novasyntax::lsp
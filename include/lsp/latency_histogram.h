@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace novasyntax::lsp {
+
+// Log2-bucketed latency histogram. Bucket i counts samples in
+// [2^(i-1), 2^i) microseconds (bucket 0 holds sub-microsecond samples);
+// the last bucket also takes everything slower.
+class LatencyHistogram {
+public:
+    static constexpr size_t kBuckets = 32;
+
+    void record(std::chrono::nanoseconds elapsed);
+
+    uint64_t count() const { return count_; }
+    double meanMicros() const;
+    double maxMicros() const { return static_cast<double>(max_ns_) / 1000.0; }
+
+    // Upper bound of the bucket holding the given quantile (0..1)
+    double percentileMicros(double quantile) const;
+
+    const std::array<uint64_t, kBuckets>& buckets() const { return buckets_; }
+    static double bucketUpperMicros(size_t bucket);
+
+private:
+    std::array<uint64_t, kBuckets> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t total_ns_ = 0;
+    uint64_t max_ns_ = 0;
+};
+
+} // namespace novasyntax::lsp
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "document_analysis.h"
+#include "json.h"
+#include "latency_histogram.h"
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace novasyntax::lsp {
+
+// Language server speaking JSON-RPC with Content-Length framing.
+//
+// Documents are analyzed on a single background worker. Every edit
+// schedules a new analysis of the latest text and cancels the one in
+// flight for the same document, so only the newest version is published.
+// Requests that need analysis results wait for the current version.
+//
+// Latency of every request/notification type (and of the analysis itself)
+// is tracked in histograms, reported through the "novasyntax/latencyStats"
+// request and written to the log stream on exit.
+class LspServer {
+public:
+    LspServer(std::istream& in, std::ostream& out, std::ostream& log = std::cerr);
+    ~LspServer();
+
+    LspServer(const LspServer&) = delete;
+    LspServer& operator=(const LspServer&) = delete;
+
+    // Serve until 'exit' or end of input. Returns the process exit code:
+    // 0 if 'shutdown' was requested first, 1 otherwise.
+    int run();
+
+private:
+    struct Document {
+        std::string text;
+        int version = 0;        // As sent by the client
+        uint64_t revision = 0;  // Bumped on every edit
+    };
+
+    struct Job {
+        std::string uri;
+        std::string text;
+        int version = 0;
+        uint64_t revision = 0;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    struct CompletedAnalysis {
+        uint64_t revision = 0;
+        std::shared_ptr<const DocumentAnalysis> analysis;
+    };
+
+    struct SemanticTokensResult {
+        std::string result_id;
+        std::vector<uint32_t> data;
+    };
+
+    std::istream& in_;
+    std::ostream& out_;
+    std::ostream& log_;
+    std::mutex out_mutex_;
+
+    // Main thread only
+    std::unordered_map<std::string, Document> documents_;
+    std::unordered_map<std::string, SemanticTokensResult> semantic_results_;
+    int next_result_id_ = 1;
+    uint64_t next_revision_ = 1;
+    bool shutdown_requested_ = false;
+
+    // Shared with the worker, guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable analysis_cv_;
+    std::map<std::string, Job> pending_;
+    std::string running_uri_;
+    std::shared_ptr<std::atomic<bool>> running_cancelled_;
+    std::unordered_map<std::string, CompletedAnalysis> analyses_;
+    std::map<std::string, LatencyHistogram> latency_;
+    uint64_t cancelled_analyses_ = 0;
+    bool stopping_ = false;
+
+    std::thread worker_;
+
+    // Skips messages with a malformed or oversized Content-Length, after
+    // reporting them. Returns false at end of input.
+    bool readMessage(std::string& body);
+    bool parseContentLength(const std::string& value, size_t& length);
+    void writeMessage(const Json& message);
+    void sendResponse(const Json& id, Json result);
+    void sendError(const Json& id, int code, const std::string& message);
+
+    // Returns false once 'exit' has been received
+    bool handleMessage(const Json& message);
+    // Returns false for methods the server does not implement
+    bool handleRequest(const std::string& method, const Json& params, Json& result);
+    void handleNotification(const std::string& method, const Json& params);
+
+    Json initializeResult() const;
+    void didOpen(const Json& params);
+    void didChange(const Json& params);
+    void didClose(const Json& params);
+    Json semanticTokensFull(const Json& params);
+    Json semanticTokensDelta(const Json& params);
+    Json definition(const Json& params);
+    Json latencyStats();
+
+    void scheduleAnalysis(const std::string& uri);
+    void cancelAnalysis(const std::string& uri);
+    std::shared_ptr<const DocumentAnalysis> currentAnalysis(const std::string& uri);
+    void workerLoop();
+    void publishDiagnostics(const std::string& uri, const DocumentAnalysis& analysis);
+    void recordLatency(const std::string& name, std::chrono::nanoseconds elapsed);
+    void stopWorker();
+    void writeLatencyReport();
+};
+
+} // namespace novasyntax::lsp
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "parser.h"
+#include <memory>
+#include <vector>
+
+namespace novasyntax {
+
+// Statically dispatched visitor over the pointer-based AST (CRTP).
+//
+// Derived classes define whichever of visitExpression / visitVariable /
+// visitFunction they need; calls are resolved at compile time, so there is
+// no virtual call or dynamic_cast per node. The defaults visit the node's
+// children in source order and return Result{}.
+//
+//   struct CallCounter : AstVisitor<CallCounter> {
+//       int calls = 0;
+//       void visitExpression(const Expression& expr) {
+//           if (expr.type == Expression::Type::CALL) calls++;
+//           visitChildren(expr);
+//       }
+//   };
+template <typename Derived, typename Result = void>
+class AstVisitor {
+public:
+    Result visit(const ASTNode& node) {
+        switch (node.kind) {
+            case NodeKind::EXPRESSION:
+                return derived().visitExpression(static_cast<const Expression&>(node));
+            case NodeKind::VARIABLE:
+                return derived().visitVariable(static_cast<const VariableDeclaration&>(node));
+            case NodeKind::FUNCTION:
+                return derived().visitFunction(static_cast<const FunctionDeclaration&>(node));
+        }
+        return Result();
+    }
+
+    // Visit every top-level node, skipping nulls left by parse errors
+    void visitProgram(const std::vector<std::unique_ptr<ASTNode>>& program) {
+        for (const auto& node : program) {
+            if (node) visit(*node);
+        }
+    }
+
+    Result visitExpression(const Expression& expr) {
+        visitChildren(expr);
+        return Result();
+    }
+
+    Result visitVariable(const VariableDeclaration& var) {
+        visitChildren(var);
+        return Result();
+    }
+
+    Result visitFunction(const FunctionDeclaration& func) {
+        visitChildren(func);
+        return Result();
+    }
+
+    void visitChildren(const Expression& expr) {
+        if (expr.left) visit(*expr.left);
+        if (expr.right) visit(*expr.right);
+        for (const auto& argument : expr.arguments) {
+            if (argument) visit(*argument);
+        }
+    }
+
+    void visitChildren(const VariableDeclaration& var) {
+        if (var.initializer) visit(*var.initializer);
+    }
+
+    void visitChildren(const FunctionDeclaration& func) {
+        for (const auto& statement : func.statements) {
+            if (statement) visit(*statement);
+        }
+        if (func.body) visit(*func.body);
+    }
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+};
+
+} // namespace novasyntax
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "parser.h"
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace novasyntax {
+
+enum class FlatNodeKind : uint8_t {
+    FUNCTION,
+    PARAMETER,
+    VARIABLE,
+    NUMBER,
+    STRING,
+    IDENTIFIER,
+    BINARY,
+    CALL
+};
+
+constexpr uint8_t kFlatNodeHasBody = 1;
+
+// One node of a FlatAst. Children come before their parent, in source
+// order, and a subtree occupies the range [index - subtree_size + 1, index].
+// Child layout per kind:
+//   FUNCTION   parameters (PARAMETER nodes), statements, then the result
+//              expression if kFlatNodeHasBody is set; `extra` = parameter count
+//   PARAMETER  none; `extra` = parameter position
+//   VARIABLE   initializer (absent if it failed to parse)
+//   BINARY     left, right
+//   CALL       arguments
+//
+// Enums are stored in single bytes, as in BinaryAstNode, so the record
+// packs without padding.
+struct FlatNode {
+    FlatNodeKind kind;
+    uint8_t op;                 // BINARY: operator TokenType
+    uint8_t value_type;         // ValueType from type inference, if it has run
+    uint8_t flags;
+    uint32_t child_count;
+    uint32_t subtree_size;      // This node plus all of its descendants
+    uint32_t extra;
+    std::string_view value;     // Name, literal text or operator
+    const ASTNode* source;      // FUNCTION for its PARAMETER nodes
+};
+
+static_assert(sizeof(FlatNode) == 16 + sizeof(std::string_view) + sizeof(const ASTNode*),
+              "FlatNode must stay packed");
+
+// Post-order array of an AST, for passes that want a linear walk over
+// contiguous memory instead of chasing unique_ptrs. Strings and `source`
+// point into the tree it was built from, which must outlive it.
+class FlatAst {
+public:
+    FlatAst() = default;
+    explicit FlatAst(const std::vector<std::unique_ptr<ASTNode>>& program) { build(program); }
+
+    // Rebuild from a program, reusing the existing storage
+    void build(const std::vector<std::unique_ptr<ASTNode>>& program);
+
+    uint32_t size() const { return static_cast<uint32_t>(nodes_.size()); }
+    const FlatNode& operator[](uint32_t index) const { return nodes_[index]; }
+    const std::vector<FlatNode>& nodes() const { return nodes_; }
+
+    // Indices of the top-level nodes, in source order
+    const std::vector<uint32_t>& roots() const { return roots_; }
+
+    // Index of the first node of the subtree rooted at `index`
+    uint32_t subtreeBegin(uint32_t index) const { return index + 1 - nodes_[index].subtree_size; }
+
+    // Child indices of a node in source order. Walks back from the last
+    // child using subtree sizes, so this costs O(child_count).
+    void children(uint32_t index, std::vector<uint32_t>& out) const;
+
+private:
+    std::vector<FlatNode> nodes_;
+    std::vector<uint32_t> roots_;
+};
+
+// Run several passes in one post-order walk. Each pass provides
+//   void visit(const FlatNode& node, uint32_t index);
+// and is called for every node before moving on to the next, so all of
+// them share a single sweep over the node array. Passes are concrete
+// types, so the calls are resolved (and usually inlined) at compile time.
+//
+// Post-order suits bottom-up passes: keep a value stack, pop
+// node.child_count results and push one for the node.
+template <typename... Passes>
+void runFusedPasses(const FlatAst& ast, Passes&... passes) {
+    const std::vector<FlatNode>& nodes = ast.nodes();
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        const FlatNode& node = nodes[i];
+        (passes.visit(node, i), ...);
+    }
+}
+
+} // namespace novasyntax
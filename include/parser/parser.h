@@ -0,0 +1,152 @@
+#pragma once
+
+#include "../lexer.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace novasyntax {
+
+// Value types assigned to nodes by the type inference pass
+enum class ValueType {
+    UNKNOWN,
+    NUMBER,
+    STRING,
+    FUNCTION
+};
+
+// Concrete class of an ASTNode, so passes can dispatch with a switch and
+// static_cast instead of dynamic_cast chains (see ast_visitor.h)
+enum class NodeKind : uint8_t {
+    EXPRESSION,
+    VARIABLE,
+    FUNCTION
+};
+
+// Base class for all AST nodes
+class ASTNode {
+public:
+    virtual ~ASTNode() = default;
+    virtual std::string toString() const = 0;
+
+    const NodeKind kind;
+
+    // Source position of the first token of the node
+    int line = 0;
+    int column = 0;
+
+    // Filled in by TypeInference; UNKNOWN until the pass has run
+    ValueType inferred_type = ValueType::UNKNOWN;
+
+protected:
+    explicit ASTNode(NodeKind node_kind) : kind(node_kind) {}
+};
+
+class Expression : public ASTNode {
+public:
+    enum class Type {
+        LITERAL,         // Number literal
+        STRING_LITERAL,
+        IDENTIFIER,
+        BINARY,          // left <op> right
+        CALL             // value(arguments...)
+    };
+
+    Expression() : ASTNode(NodeKind::EXPRESSION) {}
+
+    Type type = Type::LITERAL;
+    std::string value;  // Literal text, identifier / callee name, or operator
+
+    // BINARY only
+    TokenType op = TokenType::EOF_;
+    std::unique_ptr<Expression> left;
+    std::unique_ptr<Expression> right;
+
+    // CALL only
+    std::vector<std::unique_ptr<Expression>> arguments;
+
+    std::string toString() const override;
+};
+
+class VariableDeclaration : public ASTNode {
+public:
+    VariableDeclaration() : ASTNode(NodeKind::VARIABLE) {}
+
+    std::string name;
+    std::unique_ptr<ASTNode> initializer;
+
+    std::string toString() const override;
+};
+
+class FunctionDeclaration : public ASTNode {
+public:
+    FunctionDeclaration() : ASTNode(NodeKind::FUNCTION) {}
+
+    std::string name;
+    std::vector<std::string> parameters;
+
+    // Statements preceding the result expression (let declarations and
+    // expression statements), in source order
+    std::vector<std::unique_ptr<ASTNode>> statements;
+
+    // Result expression: the operand of 'return', or the last expression
+    // statement of the body. May be null for bodies without one.
+    std::unique_ptr<ASTNode> body;
+
+    // Filled in by TypeInference
+    std::vector<ValueType> parameter_types;
+    ValueType return_type = ValueType::UNKNOWN;
+
+    std::string toString() const override;
+};
+
+struct ParseError {
+    std::string message;
+    int line;
+    int column;
+};
+
+class Parser {
+public:
+    // With trace disabled the parser is silent: errors are only collected
+    // and available through errors()
+    explicit Parser(const std::vector<Token>& tokens, bool trace = true);
+
+    // Parse a single top-level declaration or expression
+    std::unique_ptr<ASTNode> parse();
+
+    // Parse every top-level declaration until EOF. Declarations that fail
+    // to parse are skipped after resynchronizing on the next 'func'/'let'.
+    std::vector<std::unique_ptr<ASTNode>> parseProgram();
+
+    bool hadError() const { return had_error_; }
+    const std::vector<ParseError>& errors() const { return errors_; }
+
+private:
+    std::vector<Token> tokens_;
+    size_t current_token_ = 0;
+    bool trace_;
+    bool had_error_ = false;
+    std::vector<ParseError> errors_;
+    size_t error_token_ = 0;
+
+    std::unique_ptr<FunctionDeclaration> parseFunctionDeclaration();
+    std::unique_ptr<VariableDeclaration> parseVariableDeclaration();
+    std::unique_ptr<Expression> parseExpression();
+
+    // Throwing helpers used below parseExpression
+    std::unique_ptr<Expression> parseAdditive();
+    std::unique_ptr<Expression> parseMultiplicative();
+    std::unique_ptr<Expression> parsePrimary();
+
+    Token consume(TokenType type, const std::string& error_message);
+    bool is_at_end();
+    const Token& peek();
+    const Token& previous();
+    const Token& advance();
+    void reportError(const std::string& context, const std::string& message);
+    void synchronize();
+};
+
+} // namespace novasyntax
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "interpreter.h"
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace novasyntax {
+
+// A compiled script. Immutable once Engine::compile returns it, so one
+// instance can be shared by any number of threads.
+class Script {
+public:
+    // Handle for calling a function without a lookup by name;
+    // nullptr if the script has no such function
+    const FunctionDeclaration* function(const std::string& name) const;
+
+    // Value of a top-level binding, or nullptr if there is none
+    const Value* global(const std::string& name) const;
+
+    const std::string& name() const { return name_; }
+
+private:
+    friend class Engine;
+    friend class Context;
+
+    Script() = default;
+
+    std::string name_;
+    std::vector<std::unique_ptr<ASTNode>> program_;
+    GlobalScope globals_;
+};
+
+// Per-thread execution state: just a call stack. A context holds no
+// script, so one context can run any number of scripts, one call at a
+// time. Its storage is kept between calls.
+class Context {
+public:
+    explicit Context(size_t reserved_locals = 256) { stack_.reserve(reserved_locals); }
+
+    // `func` must come from `script`. Runtime errors throw
+    // std::runtime_error and leave the context ready for the next call.
+    Value call(const Script& script, const FunctionDeclaration& func, const Value* arguments, size_t count);
+    Value call(const Script& script, const FunctionDeclaration& func, std::initializer_list<Value> arguments) {
+        return call(script, func, arguments.begin(), arguments.size());
+    }
+
+    // Looks the function up by name on every call
+    Value call(const Script& script, const std::string& name, std::initializer_list<Value> arguments);
+
+private:
+    CallStack stack_;
+};
+
+struct EngineOptions {
+    // Reject scripts with type errors at compile time
+    bool check_types = true;
+};
+
+// Embedding entry point.
+//
+//   novasyntax::Engine engine;
+//   auto script = engine.compile(source);          // once
+//   auto* area = script->function("area");
+//
+//   // on each thread
+//   novasyntax::Context context;
+//   double a = std::get<double>(context.call(*script, *area, {w, h}));
+//
+// The engine holds no state besides its options; there is no global
+// state anywhere in the runtime.
+class Engine {
+public:
+    explicit Engine(EngineOptions options = {}) : options_(options) {}
+
+    // Lex, parse and type-check `source`, then run its top-level code.
+    // Throws std::runtime_error listing every diagnostic as
+    // "name:line:column: message", one per line.
+    std::shared_ptr<const Script> compile(const std::string& source, const std::string& name = "<script>") const;
+
+private:
+    EngineOptions options_;
+};
+
+} // namespace novasyntax
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../parser/parser.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace novasyntax {
+
+// Result of a function without a result expression
+struct NoValue {};
+
+using Value = std::variant<NoValue, double, std::string, const FunctionDeclaration*>;
+
+// Top-level bindings of a program: its functions and 'let's
+using GlobalScope = std::unordered_map<std::string, Value>;
+
+constexpr int kMaxCallDepth = 1000;
+
+// Numeric value of a NUMBER token: decimal (with optional fraction and
+// exponent), 0x hexadecimal or 0b binary
+double numberLiteralValue(const std::string& text);
+
+std::string valueToString(const Value& value);
+
+// Locals of every active call on one thread of execution. Keeps its
+// capacity between calls, so once warmed up, calls that only handle
+// numbers do not allocate.
+class CallStack {
+public:
+    void reserve(size_t locals) { locals_.reserve(locals); }
+    bool empty() const { return locals_.empty(); }
+
+private:
+    friend class Evaluator;
+    friend Value callFunction(const FunctionDeclaration&, const Value*, size_t, const GlobalScope&, CallStack&);
+
+    struct Local {
+        const std::string* name;  // nullptr while arguments are evaluated
+        Value value;
+    };
+
+    std::vector<Local> locals_;
+    size_t frame_base_ = 0;
+    int depth_ = 0;
+};
+
+// Bind the functions of `program` and run its top-level 'let's and
+// expressions in source order. The program must outlive the result.
+GlobalScope evaluateGlobals(const std::vector<std::unique_ptr<ASTNode>>& program, CallStack& stack);
+
+// Call `func` with `count` arguments. `globals` is only read, so several
+// threads may share it as long as each uses its own CallStack.
+Value callFunction(const FunctionDeclaration& func, const Value* arguments, size_t count,
+                   const GlobalScope& globals, CallStack& stack);
+
+// Tree-walking interpreter over the parser's AST.
+//
+// Functions are global and may be called before their declaration; the
+// top-level 'let's and expressions run in source order on construction.
+// Runtime errors (undefined names, wrong argument counts, operands of the
+// wrong type, runaway recursion) throw std::runtime_error.
+class Interpreter {
+public:
+    explicit Interpreter(const std::vector<std::unique_ptr<ASTNode>>& program);
+
+    Value call(const std::string& name, const std::vector<Value>& arguments);
+
+    // Value of a top-level binding, or nullptr if there is none
+    const Value* global(const std::string& name) const;
+
+private:
+    CallStack stack_;
+    GlobalScope globals_;
+};
+
+} // namespace novasyntax
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../parser/parser.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace novasyntax {
+
+struct TypeDiagnostic {
+    std::string message;
+    int line;
+    int column;
+};
+
+const char* valueTypeName(ValueType type);
+
+// Hindley-Milner style inference without generalization: every binding and
+// expression gets a type variable, constraints are solved with union-find
+// (union by rank, path compression), and the solution is written back to
+// ASTNode::inferred_type. Runs in near-linear time in the size of the AST.
+//
+// Rules:
+//   - '-', '*', '/' take and produce numbers
+//   - '+' takes two operands of the same type (number or string)
+//   - a call unifies the callee with function(args...) -> result
+class TypeInference {
+public:
+    // Infer types for a parsed program and annotate its nodes in place.
+    // Returns the type errors found; empty if the program is well typed.
+    std::vector<TypeDiagnostic> run(const std::vector<std::unique_ptr<ASTNode>>& program);
+
+private:
+    struct Term {
+        int parent;
+        int rank;
+        ValueType kind;    // UNKNOWN for an unbound variable
+        int args_begin;    // FUNCTION: parameters then result in args_
+        int arity;
+    };
+
+    std::vector<Term> terms_;
+    std::vector<int> args_;
+    std::vector<std::pair<ASTNode*, int>> annotations_;
+    std::vector<std::pair<const Expression*, int>> plus_checks_;
+    std::vector<TypeDiagnostic> diagnostics_;
+    std::vector<std::pair<int, int>> unify_stack_;
+
+    std::unordered_map<std::string, int> globals_;
+    std::unordered_map<std::string, int> locals_;
+    bool in_function_ = false;
+
+    int fresh(ValueType kind = ValueType::UNKNOWN);
+    int freshFunction(int arity);
+    int find(int var);
+    bool unify(int a, int b);
+    std::string describe(int var);
+
+    int lookup(const std::string& name);
+    void inferFunction(FunctionDeclaration& func);
+    void inferVariable(VariableDeclaration& var, std::unordered_map<std::string, int>& scope);
+    int inferNode(ASTNode* node);
+    int inferExpression(Expression& expr);
+    void error(const ASTNode& node, std::string message);
+};
+
+} // namespace novasyntax
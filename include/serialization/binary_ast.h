@@ -0,0 +1,173 @@
+#pragma once
+
+#include "../parser/parser.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace novasyntax {
+
+// Flat, relocatable binary AST.
+//
+// Layout (host byte order, every section 4-byte aligned, all references are
+// indices so the file can be mapped at any address; a file written on a
+// host of the other byte order fails the version check):
+//
+//   BinaryAstHeader
+//   BinaryAstNode    nodes[node_count]       pre-order
+//   uint32_t         children[child_count]   node indices; each node owns
+//                                            one contiguous range
+//   uint32_t         string_offsets[string_count + 1]
+//   char             string_data[string_bytes]
+//
+// Top-level declarations are the range [root_begin, root_begin + root_count)
+// of the children array. Child ranges per kind:
+//   FUNCTION   parameters (PARAMETER nodes), statements, then the result
+//              expression if kHasBody is set; `extra` = parameter count
+//   VARIABLE   initializer (absent if it failed to parse)
+//   BINARY     left, right
+//   CALL       arguments
+enum class BinaryAstKind : uint8_t {
+    FUNCTION,
+    PARAMETER,
+    VARIABLE,
+    NUMBER,
+    STRING,
+    IDENTIFIER,
+    BINARY,
+    CALL
+};
+
+constexpr uint8_t kBinaryAstHasBody = 1;
+
+struct BinaryAstHeader {
+    char magic[4];          // "NSAB"
+    uint32_t version;
+    uint32_t node_count;
+    uint32_t child_count;
+    uint32_t root_begin;
+    uint32_t root_count;
+    uint32_t string_count;
+    uint32_t string_bytes;
+};
+
+struct BinaryAstNode {
+    uint8_t kind;           // BinaryAstKind
+    uint8_t op;             // BINARY: operator TokenType
+    uint8_t value_type;     // ValueType from type inference
+    uint8_t flags;
+    uint32_t value;         // String index: name, literal text or operator
+    uint32_t line;
+    uint32_t column;
+    uint32_t first_child;   // Into the children array
+    uint32_t child_count;
+    uint32_t extra;
+};
+
+static_assert(sizeof(BinaryAstHeader) == 32, "BinaryAstHeader must stay packed");
+static_assert(sizeof(BinaryAstNode) == 28, "BinaryAstNode must stay packed");
+
+constexpr uint32_t kBinaryAstVersion = 1;
+
+// Serializes parser output. Strings are interned, so repeated identifiers
+// are stored once.
+class BinaryAstWriter {
+public:
+    std::vector<char> serialize(const std::vector<std::unique_ptr<ASTNode>>& program);
+
+    // Throws std::runtime_error if the file cannot be written
+    void writeFile(const std::string& path, const std::vector<std::unique_ptr<ASTNode>>& program);
+};
+
+class BinaryAstView;
+
+// Lightweight handle to one node inside a BinaryAstView
+class BinaryAstNodeRef {
+public:
+    BinaryAstNodeRef(const BinaryAstView* view, uint32_t index) : view_(view), index_(index) {}
+
+    uint32_t index() const { return index_; }
+    BinaryAstKind kind() const { return static_cast<BinaryAstKind>(record().kind); }
+    TokenType op() const { return static_cast<TokenType>(record().op); }
+    ValueType valueType() const { return static_cast<ValueType>(record().value_type); }
+    int line() const { return static_cast<int>(record().line); }
+    int column() const { return static_cast<int>(record().column); }
+    std::string_view value() const;
+
+    uint32_t childCount() const { return record().child_count; }
+    BinaryAstNodeRef child(uint32_t i) const;
+
+    // FUNCTION only
+    uint32_t parameterCount() const { return record().extra; }
+    bool hasBody() const { return (record().flags & kBinaryAstHasBody) != 0; }
+
+private:
+    const BinaryAstView* view_;
+    uint32_t index_;
+
+    const BinaryAstNode& record() const;
+};
+
+// Zero-copy reader over a serialized AST in memory. Validates the layout,
+// including each node's children against its kind, once on construction
+// (throwing std::runtime_error if it is malformed); after that, accessors
+// read straight from the buffer.
+class BinaryAstView {
+public:
+    BinaryAstView(const void* data, size_t size);
+
+    uint32_t nodeCount() const { return header_->node_count; }
+    uint32_t rootCount() const { return header_->root_count; }
+    BinaryAstNodeRef root(uint32_t i) const { return {this, children_[header_->root_begin + i]}; }
+    BinaryAstNodeRef node(uint32_t index) const { return {this, index}; }
+
+    std::string_view string(uint32_t index) const {
+        return {strings_ + string_offsets_[index], string_offsets_[index + 1] - string_offsets_[index]};
+    }
+
+private:
+    friend class BinaryAstNodeRef;
+
+    const BinaryAstHeader* header_;
+    const BinaryAstNode* nodes_;
+    const uint32_t* children_;
+    const uint32_t* string_offsets_;
+    const char* strings_;
+
+    bool hasValidShape(const BinaryAstNode& node) const;
+};
+
+// A serialized AST file mapped read-only into memory
+class MappedBinaryAst {
+public:
+    // Throws std::runtime_error if the file cannot be mapped or is malformed
+    explicit MappedBinaryAst(const std::string& path);
+    ~MappedBinaryAst();
+
+    MappedBinaryAst(const MappedBinaryAst&) = delete;
+    MappedBinaryAst& operator=(const MappedBinaryAst&) = delete;
+
+    const BinaryAstView& view() const { return *view_; }
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    std::unique_ptr<BinaryAstView> view_;
+};
+
+inline const BinaryAstNode& BinaryAstNodeRef::record() const {
+    return view_->nodes_[index_];
+}
+
+inline std::string_view BinaryAstNodeRef::value() const {
+    return view_->string(record().value);
+}
+
+inline BinaryAstNodeRef BinaryAstNodeRef::child(uint32_t i) const {
+    return {view_, view_->children_[record().first_child + i]};
+}
+
+} // namespace novasyntax
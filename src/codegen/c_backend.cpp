@@ -0,0 +1,456 @@
+#include "../../include/codegen/c_backend.h"
+#include "../../include/runtime/interpreter.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <dlfcn.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+namespace novasyntax {
+
+namespace {
+
+// Checks whether a function body stays within the lowerable subset
+class Lowerability {
+public:
+    explicit Lowerability(const std::unordered_map<std::string, const FunctionDeclaration*>& functions)
+        : functions_(functions) {}
+
+    // Empty if lowerable; otherwise why not. `callees` receives the
+    // functions called from the body.
+    std::string check(const FunctionDeclaration& func, std::vector<std::string>& callees) {
+        callees_ = &callees;
+        if (func.return_type != ValueType::NUMBER) return "does not return a number";
+        if (func.parameters.size() > kMaxNativeArity) {
+            return "has more than " + std::to_string(kMaxNativeArity) + " parameters";
+        }
+        for (ValueType type : func.parameter_types) {
+            if (type != ValueType::NUMBER && type != ValueType::UNKNOWN) return "takes non-numeric parameters";
+        }
+
+        scope_.assign(func.parameters.begin(), func.parameters.end());
+        for (const auto& statement : func.statements) {
+            if (!statement) return "has statements that did not parse";
+            if (statement->kind == NodeKind::VARIABLE) {
+                auto& var = static_cast<const VariableDeclaration&>(*statement);
+                std::string reason = checkNode(var.initializer.get());
+                if (!reason.empty()) return reason;
+                scope_.push_back(var.name);
+            } else {
+                std::string reason = checkNode(statement.get());
+                if (!reason.empty()) return reason;
+            }
+        }
+        return checkNode(func.body.get());
+    }
+
+private:
+    const std::unordered_map<std::string, const FunctionDeclaration*>& functions_;
+    std::vector<std::string> scope_;
+    std::vector<std::string>* callees_ = nullptr;
+
+    bool isLocal(const std::string& name) const {
+        for (const auto& local : scope_) {
+            if (local == name) return true;
+        }
+        return false;
+    }
+
+    std::string checkNode(const ASTNode* node) {
+        if (!node || node->kind != NodeKind::EXPRESSION) return "has a non-expression operand";
+        auto& expr = static_cast<const Expression&>(*node);
+
+        switch (expr.type) {
+            case Expression::Type::LITERAL:
+                return "";
+            case Expression::Type::STRING_LITERAL:
+                return "uses strings";
+            case Expression::Type::IDENTIFIER:
+                if (isLocal(expr.value)) return "";
+                if (functions_.count(expr.value)) return "uses '" + expr.value + "' as a value";
+                return "reads global '" + expr.value + "'";
+            case Expression::Type::BINARY: {
+                std::string reason = checkNode(expr.left.get());
+                return reason.empty() ? checkNode(expr.right.get()) : reason;
+            }
+            case Expression::Type::CALL: {
+                auto callee = functions_.find(expr.value);
+                if (isLocal(expr.value) || callee == functions_.end()) {
+                    return "calls '" + expr.value + "', which is not a global function";
+                }
+                if (callee->second->parameters.size() != expr.arguments.size()) {
+                    return "calls '" + expr.value + "' with the wrong number of arguments";
+                }
+                for (const auto& argument : expr.arguments) {
+                    std::string reason = checkNode(argument.get());
+                    if (!reason.empty()) return reason;
+                }
+                callees_->push_back(expr.value);
+                return "";
+            }
+        }
+        return "has an unsupported expression";
+    }
+};
+
+// Functions on a call graph cycle (Tarjan's strongly connected components)
+std::unordered_set<std::string> recursiveFunctions(
+    const std::vector<const FunctionDeclaration*>& functions,
+    std::unordered_map<std::string, std::vector<std::string>>& callees) {
+    struct State {
+        int index = -1;
+        int low = 0;
+        bool on_stack = false;
+    };
+    std::unordered_map<std::string, State> states;
+    std::vector<std::string> stack;
+    std::unordered_set<std::string> recursive;
+    int next_index = 0;
+
+    auto connect = [&](auto& self, const std::string& name) -> void {
+        State& state = states[name];
+        state.index = state.low = next_index++;
+        state.on_stack = true;
+        stack.push_back(name);
+
+        for (const auto& callee : callees[name]) {
+            if (callee == name) recursive.insert(name);
+            State& next = states[callee];
+            if (next.index < 0) {
+                self(self, callee);
+                states[name].low = std::min(states[name].low, states[callee].low);
+            } else if (next.on_stack) {
+                states[name].low = std::min(states[name].low, next.index);
+            }
+        }
+
+        if (states[name].low == states[name].index) {
+            std::vector<std::string> component;
+            do {
+                component.push_back(stack.back());
+                states[stack.back()].on_stack = false;
+                stack.pop_back();
+            } while (component.back() != name);
+            if (component.size() > 1) recursive.insert(component.begin(), component.end());
+        }
+    };
+
+    for (const auto* func : functions) {
+        if (states[func->name].index < 0) connect(connect, func->name);
+    }
+    return recursive;
+}
+
+void writeNumber(std::string& out, const std::string& literal) {
+    double value = numberLiteralValue(literal);
+    if (std::isinf(value)) {
+        out += "(1.0 / 0.0)";
+        return;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    out += buffer;
+    if (std::string(buffer).find_first_of(".e") == std::string::npos) {
+        out += ".0";
+    }
+}
+
+// Emits one lowered function. Every 'let' gets its own C name, so
+// redeclaring a name in NovaSyntax never redeclares a C variable.
+class FunctionEmitter {
+public:
+    explicit FunctionEmitter(std::string& out) : out_(out) {}
+
+    void signature(const FunctionDeclaration& func) {
+        names_.clear();
+        next_id_ = 0;
+        out_ += "double ns_";
+        out_ += func.name;
+        out_ += '(';
+        if (func.parameters.empty()) out_ += "void";
+        for (size_t i = 0; i < func.parameters.size(); ++i) {
+            if (i > 0) out_ += ", ";
+            out_ += "double ";
+            names_.emplace_back(func.parameters[i], freshName(func.parameters[i]));
+            out_ += names_.back().second;
+        }
+        out_ += ')';
+    }
+
+    void body(const FunctionDeclaration& func) {
+        out_ += " {\n";
+        for (const auto& statement : func.statements) {
+            out_ += "    ";
+            if (statement->kind == NodeKind::VARIABLE) {
+                auto& var = static_cast<const VariableDeclaration&>(*statement);
+                // Bind the name after the initializer, which may still
+                // refer to an earlier binding of it
+                std::string name = freshName(var.name);
+                out_ += "double ";
+                out_ += name;
+                out_ += " = ";
+                expression(static_cast<const Expression&>(*var.initializer));
+                names_.emplace_back(var.name, std::move(name));
+            } else {
+                out_ += "(void)";
+                expression(static_cast<const Expression&>(*statement));
+            }
+            out_ += ";\n";
+        }
+        out_ += "    return ";
+        expression(static_cast<const Expression&>(*func.body));
+        out_ += ";\n}\n";
+    }
+
+private:
+    std::string& out_;
+    std::vector<std::pair<std::string, std::string>> names_;
+    int next_id_ = 0;
+
+    std::string freshName(const std::string& name) {
+        std::string fresh = std::to_string(next_id_++);
+        fresh.insert(0, 1, 'v');
+        fresh += '_';
+        fresh += name;
+        return fresh;
+    }
+
+    const std::string& resolve(const std::string& name) const {
+        for (auto it = names_.rbegin(); it != names_.rend(); ++it) {
+            if (it->first == name) return it->second;
+        }
+        throw std::logic_error("Unresolved local '" + name + "' in C backend");
+    }
+
+    void expression(const Expression& expr) {
+        switch (expr.type) {
+            case Expression::Type::LITERAL:
+                writeNumber(out_, expr.value);
+                break;
+            case Expression::Type::IDENTIFIER:
+                out_ += resolve(expr.value);
+                break;
+            case Expression::Type::BINARY:
+                out_ += '(';
+                expression(*expr.left);
+                out_ += ' ';
+                out_ += expr.value;
+                out_ += ' ';
+                expression(*expr.right);
+                out_ += ')';
+                break;
+            case Expression::Type::CALL:
+                out_ += "ns_";
+                out_ += expr.value;
+                out_ += '(';
+                for (size_t i = 0; i < expr.arguments.size(); ++i) {
+                    if (i > 0) out_ += ", ";
+                    expression(*expr.arguments[i]);
+                }
+                out_ += ')';
+                break;
+            case Expression::Type::STRING_LITERAL:
+                break;
+        }
+    }
+};
+
+} // namespace
+
+const std::string& CBackend::emit(const std::vector<std::unique_ptr<ASTNode>>& program,
+                                  const std::string& source_name) {
+    out_.clear();
+    lowered_.clear();
+    skipped_.clear();
+
+    std::vector<const FunctionDeclaration*> candidates;
+    std::unordered_map<std::string, const FunctionDeclaration*> functions;
+    for (const auto& node : program) {
+        if (node && node->kind == NodeKind::FUNCTION) {
+            auto* func = static_cast<const FunctionDeclaration*>(node.get());
+            if (functions.emplace(func->name, func).second) {
+                candidates.push_back(func);
+            } else {
+                skipped_.push_back({func->name, "is defined more than once", func->line});
+            }
+        }
+    }
+
+    Lowerability lowerability(functions);
+    std::unordered_map<std::string, std::vector<std::string>> callees;
+    std::unordered_map<std::string, std::string> reasons;
+    for (const auto* func : candidates) {
+        std::string reason = lowerability.check(*func, callees[func->name]);
+        if (!reason.empty()) reasons.emplace(func->name, reason);
+    }
+
+    // Without conditionals, any recursion is infinite. Leave it to the
+    // interpreter's call depth limit rather than overflowing the C stack.
+    for (const auto& name : recursiveFunctions(candidates, callees)) {
+        reasons.emplace(name, "is recursive");
+    }
+
+    // Drop callers of skipped functions until nothing changes
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (const auto* func : candidates) {
+            if (reasons.count(func->name)) continue;
+            for (const auto& callee : callees[func->name]) {
+                if (reasons.count(callee)) {
+                    reasons.emplace(func->name, "calls '" + callee + "', which is not lowered");
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::vector<const FunctionDeclaration*> lowered;
+    for (const auto* func : candidates) {
+        auto reason = reasons.find(func->name);
+        if (reason != reasons.end()) {
+            skipped_.push_back({func->name, reason->second, func->line});
+        } else {
+            lowered.push_back(func);
+            lowered_.push_back({func->name, func->parameters.size()});
+        }
+    }
+
+    out_ += "/* Generated by novasyntax build";
+    if (!source_name.empty()) {
+        // A '*/' in the path would end the comment early
+        out_ += " from ";
+        for (size_t i = 0; i < source_name.size(); ++i) {
+            out_ += source_name[i];
+            if (source_name[i] == '*' && i + 1 < source_name.size() && source_name[i + 1] == '/') {
+                out_ += ' ';
+            }
+        }
+    }
+    out_ += ". Do not edit. */\n\n";
+    out_ += "typedef struct {\n    const char* name;\n    int arity;\n} novasyntax_export;\n\n";
+
+    FunctionEmitter emitter(out_);
+    for (const auto* func : lowered) {
+        emitter.signature(*func);
+        out_ += ";\n";
+    }
+    for (const auto* func : lowered) {
+        out_ += '\n';
+        emitter.signature(*func);
+        emitter.body(*func);
+    }
+
+    out_ += "\nconst novasyntax_export novasyntax_exports[] = {\n";
+    for (const auto& func : lowered_) {
+        out_ += "    {\"";
+        out_ += func.name;
+        out_ += "\", ";
+        out_ += std::to_string(func.arity);
+        out_ += "},\n";
+    }
+    out_ += "    {0, 0}\n};\n";
+    return out_;
+}
+
+bool compileSharedObject(const std::string& c_path, const std::string& so_path, std::string& error) {
+    const char* env = std::getenv("CC");
+    std::string compiler = env && *env ? env : "cc";
+
+    // No contraction of a * b + c into FMA: results must round exactly as
+    // the interpreter's do
+    std::vector<std::string> args = {compiler, "-std=c99", "-O2", "-ffp-contract=off",
+                                      "-shared", "-fPIC", "-o", so_path, c_path};
+    std::vector<char*> argv;
+    for (auto& arg : args) argv.push_back(arg.data());
+    argv.push_back(nullptr);
+
+    pid_t pid;
+    if (posix_spawnp(&pid, compiler.c_str(), nullptr, nullptr, argv.data(), environ) != 0) {
+        error = "Cannot run C compiler '" + compiler + "'";
+        return false;
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        error = "C compiler '" + compiler + "' failed";
+        return false;
+    }
+    return true;
+}
+
+double NativeFunction::call(const double* a) const {
+    switch (arity) {
+        case 0: return reinterpret_cast<double (*)()>(address)();
+        case 1: return reinterpret_cast<double (*)(double)>(address)(a[0]);
+        case 2: return reinterpret_cast<double (*)(double, double)>(address)(a[0], a[1]);
+        case 3: return reinterpret_cast<double (*)(double, double, double)>(address)(a[0], a[1], a[2]);
+        case 4:
+            return reinterpret_cast<double (*)(double, double, double, double)>(address)(a[0], a[1], a[2], a[3]);
+        case 5:
+            return reinterpret_cast<double (*)(double, double, double, double, double)>(address)(
+                a[0], a[1], a[2], a[3], a[4]);
+        case 6:
+            return reinterpret_cast<double (*)(double, double, double, double, double, double)>(address)(
+                a[0], a[1], a[2], a[3], a[4], a[5]);
+        case 7:
+            return reinterpret_cast<double (*)(double, double, double, double, double, double, double)>(address)(
+                a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+        default:
+            return reinterpret_cast<double (*)(double, double, double, double, double, double, double, double)>(
+                address)(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+    }
+}
+
+NativeModule::NativeModule(const std::string& path) {
+    // dlopen searches the library path for names without a slash
+    std::string resolved = path.find('/') == std::string::npos ? "./" + path : path;
+    handle_ = ::dlopen(resolved.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle_) {
+        const char* reason = ::dlerror();
+        throw std::runtime_error("Cannot load " + path + ": " + (reason ? reason : "unknown error"));
+    }
+
+    struct Export {
+        const char* name;
+        int arity;
+    };
+    auto* exports = static_cast<const Export*>(::dlsym(handle_, "novasyntax_exports"));
+    if (!exports) {
+        ::dlclose(handle_);
+        throw std::runtime_error(path + " was not built by novasyntax build");
+    }
+
+    for (; exports->name; ++exports) {
+        std::string symbol = "ns_";
+        symbol += exports->name;
+        void* address = ::dlsym(handle_, symbol.c_str());
+        if (!address || exports->arity < 0 || static_cast<size_t>(exports->arity) > kMaxNativeArity) {
+            // The name lives in the library, so copy it before unloading
+            std::string message = path + ": bad export '" + exports->name + "'";
+            ::dlclose(handle_);
+            throw std::runtime_error(message);
+        }
+        functions_.push_back({exports->name, static_cast<size_t>(exports->arity), address});
+    }
+}
+
+NativeModule::~NativeModule() {
+    if (handle_) {
+        ::dlclose(handle_);
+    }
+}
+
+const NativeFunction* NativeModule::function(const std::string& name) const {
+    for (const auto& func : functions_) {
+        if (func.name == name) return &func;
+    }
+    return nullptr;
+}
+
+} // namespace novasyntax
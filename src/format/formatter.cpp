@@ -0,0 +1,301 @@
+#include "../../include/format/formatter.h"
+#include "../../include/lexer.hpp"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+namespace novasyntax {
+
+namespace {
+
+constexpr int kPrimaryPrecedence = 3;
+
+int precedence(const Expression& expr) {
+    if (expr.type != Expression::Type::BINARY) {
+        return kPrimaryPrecedence;
+    }
+    switch (expr.op) {
+        case TokenType::MULTIPLY:
+        case TokenType::DIVIDE:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+} // namespace
+
+Formatter::Formatter(FormatOptions options) : options_(options) {}
+
+const std::string& Formatter::format(const std::vector<std::unique_ptr<ASTNode>>& program,
+                                     const SourceComments* comments) {
+    out_.clear();
+    comments_ = comments;
+    next_comment_ = 0;
+    closed_line_ = std::string::npos;
+
+    bool previous_was_function = false;
+    for (size_t i = 0; i < program.size(); ++i) {
+        const ASTNode* node = program[i].get();
+        if (!node) continue;
+
+        // Comments before a function stay attached to it, after the blank line
+        bool is_function = node->kind == NodeKind::FUNCTION;
+        flushTrailingComments(node->line, node->column);
+        if (!out_.empty() && (is_function || previous_was_function)) {
+            out_ += '\n';
+        }
+        bool at_start = out_.empty();
+        flushComments(node->line, node->column, 0);
+        if (at_start && !out_.empty() && blankLineAfter(comments_->trivia[next_comment_ - 1])) {
+            // A file header stays separated from the code below it
+            out_ += '\n';
+        }
+        writeTopLevel(*node);
+        previous_was_function = is_function;
+    }
+    flushComments(INT_MAX, INT_MAX, 0);
+
+    comments_ = nullptr;
+    return out_;
+}
+
+bool Formatter::formatSource(const std::string& source, std::string& out, std::string& error) {
+    Lexer lexer(source, CommentMode::PRESERVE);
+    std::vector<Token> tokens;
+    try {
+        tokens = lexer.tokenize();
+    } catch (const std::runtime_error& e) {
+        error = e.what();
+        return false;
+    }
+
+    Parser parser(tokens, false);
+    auto program = parser.parseProgram();
+    if (parser.hadError()) {
+        const auto& errors = parser.errors();
+        error = errors.empty() ? "Parse error"
+                               : std::to_string(errors.front().line) + ":" +
+                                 std::to_string(errors.front().column) + ": " + errors.front().message;
+        return false;
+    }
+
+    SourceComments comments{source, tokens, lexer.trivia()};
+    out = format(program, &comments);
+    return true;
+}
+
+bool Formatter::hasCommentBefore(int line, int column) const {
+    if (!comments_ || next_comment_ >= comments_->trivia.size()) return false;
+    const Trivia& comment = comments_->trivia[next_comment_];
+    return comment.line < line || (comment.line == line && comment.column < column);
+}
+
+bool Formatter::blankLineAfter(const Trivia& comment) const {
+    const std::string& source = comments_->source;
+    size_t newlines = 0;
+    for (size_t i = comment.end; i < source.size() && std::isspace(static_cast<unsigned char>(source[i])); ++i) {
+        newlines += source[i] == '\n';
+    }
+    return newlines >= 2;
+}
+
+void Formatter::flushTrailingComments(int line, int column) {
+    // Trailing comments come first in any run of comments between tokens.
+    // Nothing more goes on a line once a '//' or multi-line comment ends
+    // it, and none go on a blank line; flushComments puts the rest on lines
+    // of their own.
+    while (hasCommentBefore(line, column) && comments_->trivia[next_comment_].trailing &&
+           out_.size() >= 2 && out_.back() == '\n' && out_[out_.size() - 2] != '\n' &&
+           out_.size() != closed_line_) {
+        const Trivia& comment = comments_->trivia[next_comment_++];
+        out_.pop_back();
+        out_ += ' ';
+        writeComment(comment);
+        out_ += '\n';
+
+        const char* text = comments_->source.data() + comment.begin;
+        if (text[1] == '/' || std::memchr(text, '\n', comment.end - comment.begin)) {
+            closed_line_ = out_.size();
+        }
+    }
+}
+
+void Formatter::flushComments(int line, int column, int depth) {
+    flushTrailingComments(line, column);
+    while (hasCommentBefore(line, column)) {
+        // Keep a blank line that separated the comment from what precedes
+        // it, except at the start of the file or a block
+        const std::string& source = comments_->source;
+        size_t newlines = 0;
+        for (size_t i = comments_->trivia[next_comment_].begin;
+             i > 0 && std::isspace(static_cast<unsigned char>(source[i - 1])); --i) {
+            newlines += source[i - 1] == '\n';
+        }
+        bool block_start = out_.size() >= 2 && out_.compare(out_.size() - 2, 2, "{\n") == 0;
+        bool blank_before = out_.size() >= 2 && out_.compare(out_.size() - 2, 2, "\n\n") == 0;
+        if (newlines >= 2 && !out_.empty() && !block_start && !blank_before) {
+            out_ += '\n';
+        }
+
+        writeIndent(depth);
+        writeComment(comments_->trivia[next_comment_++]);
+        out_ += '\n';
+    }
+}
+
+void Formatter::writeComment(const Trivia& comment) {
+    // Line comments lose trailing whitespace; block comments are verbatim
+    size_t end = comment.end;
+    while (end > comment.begin && std::isspace(static_cast<unsigned char>(comments_->source[end - 1]))) {
+        end--;
+    }
+    out_.append(comments_->source, comment.begin, end - comment.begin);
+}
+
+void Formatter::closingBrace(const FunctionDeclaration& func, int& line, int& column) const {
+    line = INT_MAX;
+    column = INT_MAX;
+    if (!comments_) return;
+
+    const auto& tokens = comments_->tokens;
+    auto it = std::lower_bound(tokens.begin(), tokens.end(), func, [](const Token& token, const ASTNode& node) {
+        return token.line < node.line || (token.line == node.line && token.column < node.column);
+    });
+
+    int depth = 0;
+    for (; it != tokens.end(); ++it) {
+        if (it->type == TokenType::LBRACE) {
+            depth++;
+        } else if (it->type == TokenType::RBRACE && --depth == 0) {
+            line = it->line;
+            column = it->column;
+            return;
+        }
+    }
+}
+
+void Formatter::writeTopLevel(const ASTNode& node) {
+    if (node.kind == NodeKind::FUNCTION) {
+        writeFunction(static_cast<const FunctionDeclaration&>(node));
+    } else {
+        writeStatement(node, 0);
+    }
+}
+
+void Formatter::writeFunction(const FunctionDeclaration& func) {
+    out_ += "func ";
+    out_ += func.name;
+    out_ += '(';
+    for (size_t i = 0; i < func.parameters.size(); ++i) {
+        if (i > 0) out_ += ", ";
+        out_ += func.parameters[i];
+    }
+    out_ += ')';
+
+    int close_line = 0;
+    int close_column = 0;
+    closingBrace(func, close_line, close_column);
+
+    if (func.statements.empty() && !func.body && !hasCommentBefore(close_line, close_column)) {
+        out_ += " {}\n";
+        return;
+    }
+
+    out_ += " {\n";
+    for (const auto& statement : func.statements) {
+        if (!statement) continue;
+        flushComments(statement->line, statement->column, 1);
+        writeStatement(*statement, 1);
+    }
+    if (func.body) {
+        flushComments(func.body->line, func.body->column, 1);
+        writeIndent(1);
+        out_ += "return ";
+        writeNode(func.body.get());
+        out_ += '\n';
+    }
+    flushComments(close_line, close_column, 1);
+    out_ += "}\n";
+}
+
+void Formatter::writeVariable(const VariableDeclaration& var, int depth) {
+    writeIndent(depth);
+    out_ += "let ";
+    out_ += var.name;
+    out_ += " = ";
+    writeNode(var.initializer.get());
+    out_ += '\n';
+}
+
+void Formatter::writeStatement(const ASTNode& node, int depth) {
+    if (node.kind == NodeKind::VARIABLE) {
+        writeVariable(static_cast<const VariableDeclaration&>(node), depth);
+        return;
+    }
+    writeIndent(depth);
+    writeNode(&node);
+    out_ += '\n';
+}
+
+void Formatter::writeNode(const ASTNode* node) {
+    if (node && node->kind == NodeKind::EXPRESSION) {
+        writeExpression(static_cast<const Expression&>(*node));
+    }
+}
+
+void Formatter::writeExpression(const Expression& expr) {
+    switch (expr.type) {
+        case Expression::Type::LITERAL:
+        case Expression::Type::IDENTIFIER:
+            out_ += expr.value;
+            break;
+
+        case Expression::Type::STRING_LITERAL:
+            out_ += '"';
+            out_ += expr.value;
+            out_ += '"';
+            break;
+
+        case Expression::Type::CALL:
+            out_ += expr.value;
+            out_ += '(';
+            for (size_t i = 0; i < expr.arguments.size(); ++i) {
+                if (i > 0) out_ += ", ";
+                if (expr.arguments[i]) writeExpression(*expr.arguments[i]);
+            }
+            out_ += ')';
+            break;
+
+        case Expression::Type::BINARY: {
+            int own = precedence(expr);
+            writeOperand(expr.left.get(), own, false);
+            out_ += ' ';
+            out_ += expr.value;
+            out_ += ' ';
+            writeOperand(expr.right.get(), own, true);
+            break;
+        }
+    }
+}
+
+void Formatter::writeOperand(const Expression* operand, int parent_precedence, bool right_side) {
+    if (!operand) return;
+
+    // Operators are left-associative: a right operand of equal precedence
+    // keeps its parentheses so the tree shape survives a round trip
+    int own = precedence(*operand);
+    bool parenthesize = own < parent_precedence || (right_side && own == parent_precedence);
+
+    if (parenthesize) out_ += '(';
+    writeExpression(*operand);
+    if (parenthesize) out_ += ')';
+}
+
+void Formatter::writeIndent(int depth) {
+    out_.append(static_cast<size_t>(depth * options_.indent_width), ' ');
+}
+
+} // namespace novasyntax
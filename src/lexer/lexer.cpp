@@ -2,20 +2,22 @@
 #include <iostream>
 #include <stdexcept>
 #include <cctype>
+#include <cstring>
 
 namespace novasyntax {
 
-Lexer::Lexer(const std::string& source) 
-    : source(source), current(0), line(1), column(1) {}
+Lexer::Lexer(const std::string& source, CommentMode comments) 
+    : source(source), current(0), line(1), column(1), comment_mode(comments) {}
 
 std::vector<Token> Lexer::tokenize() {
     std::vector<Token> tokens;
     current = 0;
     line = 1;
     column = 1;
+    comment_trivia.clear();
 
     while (!isAtEnd()) {
-        skipWhitespace();
+        skipWhitespace(tokens.size());
         start = current;
         if (isAtEnd()) break;
 
@@ -25,7 +27,7 @@ std::vector<Token> Lexer::tokenize() {
             case '(': {
                 tokens.push_back({TokenType::LPAREN, "(", line, column});
                 advance();
-                skipWhitespace();
+                skipWhitespace(tokens.size());
                 
                 // Explicitly capture identifier after LPAREN
                 if (!isAtEnd() && (std::isalpha(peek()) || peek() == '_')) {
@@ -49,7 +51,7 @@ std::vector<Token> Lexer::tokenize() {
             case ',': {
                 tokens.push_back({TokenType::COMMA, ",", line, column});
                 advance();
-                skipWhitespace();
+                skipWhitespace(tokens.size());
                 
                 // Explicitly capture identifier after COMMA
                 if (!isAtEnd() && (std::isalpha(peek()) || peek() == '_')) {
@@ -74,7 +76,7 @@ std::vector<Token> Lexer::tokenize() {
                     tokens.push_back(stringToken());
                 }
                 else {
-                    skipWhitespace();
+                    skipWhitespace(tokens.size());
                     if (!isAtEnd()) {
                         advance(); // Ensure progress
                     }
@@ -102,16 +104,69 @@ bool Lexer::isAtEnd() {
     return current >= source.length();
 }
 
-void Lexer::skipWhitespace() {
-    while (!isAtEnd() && std::isspace(peek())) {
-        if (peek() == '\n') {
+void Lexer::skipWhitespace(size_t next_token) {
+    // A comment trails the previous token if no newline separates them
+    bool same_line = next_token > 0;
+
+    while (!isAtEnd()) {
+        char ch = peek();
+        if (ch == '/' && current + 1 < source.length() &&
+            (source[current + 1] == '/' || source[current + 1] == '*')) {
+            int comment_line = line;
+            skipComment(next_token, same_line);
+            if (line != comment_line) same_line = false;
+            continue;
+        }
+        if (!std::isspace(ch)) break;
+        if (ch == '\n') {
             line++;
-            column = 1;
+            column = 0; // advance() below moves onto column 1
+            same_line = false;
         }
         advance();
     }
 }
 
+void Lexer::skipComment(size_t next_token, bool trailing) {
+    size_t begin = current;
+    int begin_line = line;
+    int begin_column = column;
+    const char* data = source.data();
+
+    if (source[current + 1] == '/') {
+        // Runs to the end of the line; the newline is left for skipWhitespace
+        const void* newline = std::memchr(data + current, '\n', source.length() - current);
+        size_t end = newline ? static_cast<size_t>(static_cast<const char*>(newline) - data) : source.length();
+        column += static_cast<int>(end - current);
+        current = end;
+    } else {
+        size_t close = source.find("*/", current + 2);
+        if (close == std::string::npos) {
+            throw std::runtime_error("Unterminated block comment");
+        }
+        size_t end = close + 2;
+
+        // Line and column after the comment, from the last newline inside it
+        size_t last_newline = std::string::npos;
+        for (const char* p = data + current;
+             (p = static_cast<const char*>(std::memchr(p, '\n', data + end - p))) != nullptr; ++p) {
+            line++;
+            last_newline = static_cast<size_t>(p - data);
+        }
+        if (last_newline == std::string::npos) {
+            column += static_cast<int>(end - current);
+        } else {
+            column = static_cast<int>(end - last_newline);
+        }
+        current = end;
+    }
+
+    if (comment_mode == CommentMode::PRESERVE) {
+        comment_trivia.push_back({begin, current, begin_line, begin_column,
+                                  trailing ? next_token - 1 : next_token, trailing});
+    }
+}
+
 Token Lexer::createToken(TokenType type) {
     Token token{type, std::string(1, advance()), line, static_cast<int>(column - 1)};
     return token;
@@ -144,6 +199,7 @@ Token Lexer::identifierToken() {
 
 Token Lexer::numberToken() {
     size_t start = current;
+    int start_column = column;
     bool hasExponent = false;
 
     // Check for hex or binary literals
@@ -174,6 +230,7 @@ Token Lexer::numberToken() {
         } else {
             // Revert back for decimal processing
             current = start;
+            column = start_column;
         }
     }
 
@@ -223,7 +280,7 @@ Token Lexer::stringToken() {
     while (!isAtEnd() && peek() != '"') {
         if (peek() == '\n') {
             line++;
-            column = 1;
+            column = 0; // advance() below moves onto column 1
         }
         advance();
     }
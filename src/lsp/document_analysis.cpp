@@ -0,0 +1,279 @@
+#include "../../include/lsp/document_analysis.h"
+#include "../../include/lexer.hpp"
+#include "../../include/parser/parser.h"
+#include "../../include/semantic/type_inference.h"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace novasyntax::lsp {
+
+namespace {
+
+// Length of the token starting at a 0-based position, 1 if there is none.
+// Tokens are in source order, so this is a binary search.
+int tokenLengthAt(const std::vector<Token>& tokens, int line, int column) {
+    auto it = std::lower_bound(tokens.begin(), tokens.end(), std::make_pair(line, column),
+                               [](const Token& token, const std::pair<int, int>& position) {
+                                   return std::make_pair(token.line - 1, token.column - 1) < position;
+                               });
+    if (it != tokens.end() && it->line - 1 == line && it->column - 1 == column && it->type != TokenType::EOF_) {
+        int quotes = it->type == TokenType::STRING ? 2 : 0;
+        return std::max(1, static_cast<int>(it->literal.size()) + quotes);
+    }
+    return 1;
+}
+
+// Resolve identifiers to declarations from the token stream alone, so
+// navigation keeps working while the document does not parse. Top-level
+// 'func'/'let' names are global (and may be used before they appear);
+// parameters and 'let's inside a function body are local to it.
+void resolveSymbols(const std::vector<Token>& tokens, std::vector<Symbol>& symbols) {
+    std::unordered_map<std::string, int> globals;
+    std::vector<std::pair<size_t, std::string>> global_refs;
+    std::vector<std::pair<std::string, int>> locals;
+
+    int depth = 0;
+    int body_depth = -1;          // Brace depth of the current function body
+    bool in_parameters = false;
+    bool expect_function_name = false;
+    bool expect_variable_name = false;
+
+    auto addSymbol = [&](const Token& token, SemanticTokenType kind) {
+        symbols.push_back({token.line - 1, token.column - 1,
+                           static_cast<int>(token.literal.size()), kind, -1});
+        return static_cast<int>(symbols.size() - 1);
+    };
+
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        const Token& token = tokens[i];
+
+        // A declared name must directly follow its keyword
+        if (token.type != TokenType::IDENTIFIER) {
+            expect_function_name = false;
+            expect_variable_name = false;
+        }
+
+        switch (token.type) {
+            case TokenType::FUNCTION:
+                expect_function_name = true;
+                continue;
+            case TokenType::LET:
+                expect_variable_name = true;
+                continue;
+            case TokenType::LBRACE:
+                depth++;
+                if (in_parameters) in_parameters = false;
+                continue;
+            case TokenType::RBRACE:
+                if (depth == body_depth) {
+                    body_depth = -1;
+                    locals.clear();
+                }
+                depth = std::max(0, depth - 1);
+                continue;
+            case TokenType::RPAREN:
+                if (in_parameters) {
+                    in_parameters = false;
+                    body_depth = depth + 1;
+                }
+                continue;
+            case TokenType::IDENTIFIER:
+                break;
+            default:
+                continue;
+        }
+
+        bool in_body = body_depth >= 0;
+
+        if (expect_function_name) {
+            expect_function_name = false;
+            int index = addSymbol(token, SemanticTokenType::FUNCTION);
+            symbols[index].definition = index;
+            if (in_body) {
+                locals.emplace_back(token.literal, index);
+            } else {
+                globals.emplace(token.literal, index);
+                locals.clear();
+                in_parameters = true;
+            }
+            continue;
+        }
+
+        if (in_parameters) {
+            int index = addSymbol(token, SemanticTokenType::PARAMETER);
+            symbols[index].definition = index;
+            locals.emplace_back(token.literal, index);
+            continue;
+        }
+
+        if (expect_variable_name) {
+            expect_variable_name = false;
+            int index = addSymbol(token, SemanticTokenType::VARIABLE);
+            symbols[index].definition = index;
+            if (in_body) {
+                locals.emplace_back(token.literal, index);
+            } else {
+                globals.emplace(token.literal, index);
+            }
+            continue;
+        }
+
+        bool is_call = i + 1 < tokens.size() && tokens[i + 1].type == TokenType::LPAREN;
+        int index = addSymbol(token, is_call ? SemanticTokenType::FUNCTION : SemanticTokenType::VARIABLE);
+
+        // Innermost (latest) local declaration wins
+        auto local = std::find_if(locals.rbegin(), locals.rend(),
+                                  [&](const auto& entry) { return entry.first == token.literal; });
+        if (in_body && local != locals.rend()) {
+            symbols[index].definition = local->second;
+            symbols[index].kind = symbols[local->second].kind;
+        } else {
+            global_refs.emplace_back(index, token.literal);
+        }
+    }
+
+    for (const auto& [index, name] : global_refs) {
+        auto global = globals.find(name);
+        if (global != globals.end()) {
+            symbols[index].definition = global->second;
+            symbols[index].kind = symbols[global->second].kind;
+        }
+    }
+}
+
+void encodeSemanticTokens(const std::vector<Token>& tokens, const std::vector<Symbol>& symbols,
+                          std::vector<uint32_t>& data) {
+    data.clear();
+    data.reserve(tokens.size() * 5);
+
+    int previous_line = 0;
+    int previous_column = 0;
+    size_t next_symbol = 0;
+
+    auto emit = [&](int line, int column, int length, SemanticTokenType type, uint32_t modifiers) {
+        int delta_line = line - previous_line;
+        int delta_column = delta_line == 0 ? column - previous_column : column;
+        data.push_back(static_cast<uint32_t>(delta_line));
+        data.push_back(static_cast<uint32_t>(delta_column));
+        data.push_back(static_cast<uint32_t>(length));
+        data.push_back(static_cast<uint32_t>(type));
+        data.push_back(modifiers);
+        previous_line = line;
+        previous_column = column;
+    };
+
+    for (const auto& token : tokens) {
+        int line = token.line - 1;
+        int column = token.column - 1;
+        int length = static_cast<int>(token.literal.size());
+
+        switch (token.type) {
+            case TokenType::FUNCTION:
+            case TokenType::LET:
+            case TokenType::IF:
+            case TokenType::ELSE:
+            case TokenType::RETURN:
+                emit(line, column, length, SemanticTokenType::KEYWORD, 0);
+                break;
+            case TokenType::NUMBER:
+                emit(line, column, length, SemanticTokenType::NUMBER, 0);
+                break;
+            case TokenType::STRING:
+                // Multi-line tokens are not representable without client support
+                if (token.literal.find('\n') == std::string::npos) {
+                    emit(line, column, length + 2, SemanticTokenType::STRING, 0);
+                }
+                break;
+            case TokenType::PLUS:
+            case TokenType::MINUS:
+            case TokenType::MULTIPLY:
+            case TokenType::DIVIDE:
+            case TokenType::ASSIGN:
+                emit(line, column, length, SemanticTokenType::OPERATOR, 0);
+                break;
+            case TokenType::IDENTIFIER: {
+                if (next_symbol >= symbols.size()) break;
+                const Symbol& symbol = symbols[next_symbol];
+                bool declaration = symbol.definition == static_cast<int>(next_symbol);
+                emit(line, column, length, symbol.kind, declaration ? kDeclarationModifier : 0);
+                next_symbol++;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+} // namespace
+
+const std::vector<std::string>& semanticTokenTypes() {
+    static const std::vector<std::string> types = {
+        "keyword", "function", "parameter", "variable", "number", "string", "operator"
+    };
+    return types;
+}
+
+const std::vector<std::string>& semanticTokenModifiers() {
+    static const std::vector<std::string> modifiers = {"declaration"};
+    return modifiers;
+}
+
+bool analyzeDocument(const std::string& text, const std::atomic<bool>& cancelled, DocumentAnalysis& out) {
+    out.diagnostics.clear();
+    out.symbols.clear();
+    out.semantic_tokens.clear();
+
+    std::vector<Token> tokens;
+    try {
+        Lexer lexer(text);
+        tokens = lexer.tokenize();
+    } catch (const std::runtime_error& e) {
+        out.diagnostics.push_back({0, 0, 1, std::string("Lexer error: ") + e.what()});
+        return !cancelled.load();
+    }
+    if (cancelled.load()) return false;
+
+    resolveSymbols(tokens, out.symbols);
+    encodeSemanticTokens(tokens, out.symbols, out.semantic_tokens);
+    if (cancelled.load()) return false;
+
+    Parser parser(tokens, false);
+    auto program = parser.parseProgram();
+    for (const auto& error : parser.errors()) {
+        int line = std::max(0, error.line - 1);
+        int column = std::max(0, error.column - 1);
+        out.diagnostics.push_back({line, column, tokenLengthAt(tokens, line, column), error.message});
+    }
+    if (cancelled.load()) return false;
+
+    // Type errors on a partial tree are mostly noise; wait for a clean parse
+    if (!parser.hadError()) {
+        TypeInference inference;
+        for (const auto& error : inference.run(program)) {
+            int line = std::max(0, error.line - 1);
+            int column = std::max(0, error.column - 1);
+            out.diagnostics.push_back({line, column, tokenLengthAt(tokens, line, column), error.message});
+        }
+    }
+
+    return !cancelled.load();
+}
+
+int symbolAt(const DocumentAnalysis& analysis, int line, int column) {
+    const auto& symbols = analysis.symbols;
+    auto it = std::upper_bound(symbols.begin(), symbols.end(), std::make_pair(line, column),
+                               [](const std::pair<int, int>& position, const Symbol& symbol) {
+                                   return position < std::make_pair(symbol.line, symbol.column);
+                               });
+    if (it == symbols.begin()) return -1;
+    --it;
+    if (it->line == line && column >= it->column && column <= it->column + it->length) {
+        return static_cast<int>(it - symbols.begin());
+    }
+    return -1;
+}
+
+} // namespace novasyntax::lsp
@@ -0,0 +1,332 @@
+#include "../../include/lsp/json.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace novasyntax::lsp {
+
+namespace {
+
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) : text_(text), pos_(0) {}
+
+    Json readDocument() {
+        Json value = readValue(0);
+        skipWhitespace();
+        if (pos_ != text_.size()) {
+            fail("Trailing characters after JSON value");
+        }
+        return value;
+    }
+
+private:
+    static constexpr int kMaxDepth = 256;
+
+    std::string_view text_;
+    size_t pos_;
+
+    [[noreturn]] void fail(const char* message) {
+        throw std::runtime_error(std::string(message) + " at offset " + std::to_string(pos_));
+    }
+
+    void skipWhitespace() {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) {
+            pos_++;
+        }
+    }
+
+    bool consumeLiteral(std::string_view literal) {
+        if (text_.substr(pos_, literal.size()) == literal) {
+            pos_ += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    Json readValue(int depth) {
+        if (depth > kMaxDepth) fail("JSON nesting too deep");
+        skipWhitespace();
+        if (pos_ >= text_.size()) fail("Unexpected end of JSON");
+
+        char ch = text_[pos_];
+        switch (ch) {
+            case '{': return readObject(depth);
+            case '[': return readArray(depth);
+            case '"': return Json(readString());
+            case 't': if (consumeLiteral("true")) return Json(true); break;
+            case 'f': if (consumeLiteral("false")) return Json(false); break;
+            case 'n': if (consumeLiteral("null")) return Json(nullptr); break;
+            default:
+                if (ch == '-' || (ch >= '0' && ch <= '9')) return readNumber();
+        }
+        fail("Invalid JSON value");
+    }
+
+    Json readObject(int depth) {
+        pos_++; // '{'
+        Json::Object object;
+        skipWhitespace();
+        if (pos_ < text_.size() && text_[pos_] == '}') {
+            pos_++;
+            return Json(std::move(object));
+        }
+        while (true) {
+            skipWhitespace();
+            if (pos_ >= text_.size() || text_[pos_] != '"') fail("Expect string key in JSON object");
+            std::string key = readString();
+            skipWhitespace();
+            if (pos_ >= text_.size() || text_[pos_] != ':') fail("Expect ':' in JSON object");
+            pos_++;
+            object.emplace_back(std::move(key), readValue(depth + 1));
+            skipWhitespace();
+            if (pos_ < text_.size() && text_[pos_] == ',') { pos_++; continue; }
+            if (pos_ < text_.size() && text_[pos_] == '}') { pos_++; break; }
+            fail("Expect ',' or '}' in JSON object");
+        }
+        return Json(std::move(object));
+    }
+
+    Json readArray(int depth) {
+        pos_++; // '['
+        Json::Array array;
+        skipWhitespace();
+        if (pos_ < text_.size() && text_[pos_] == ']') {
+            pos_++;
+            return Json(std::move(array));
+        }
+        while (true) {
+            array.push_back(readValue(depth + 1));
+            skipWhitespace();
+            if (pos_ < text_.size() && text_[pos_] == ',') { pos_++; continue; }
+            if (pos_ < text_.size() && text_[pos_] == ']') { pos_++; break; }
+            fail("Expect ',' or ']' in JSON array");
+        }
+        return Json(std::move(array));
+    }
+
+    Json readNumber() {
+        size_t start = pos_;
+        if (text_[pos_] == '-') pos_++;
+        while (pos_ < text_.size() &&
+               ((text_[pos_] >= '0' && text_[pos_] <= '9') || text_[pos_] == '.' ||
+                text_[pos_] == 'e' || text_[pos_] == 'E' || text_[pos_] == '+' || text_[pos_] == '-')) {
+            pos_++;
+        }
+        std::string literal(text_.substr(start, pos_ - start));
+        char* end = nullptr;
+        double value = std::strtod(literal.c_str(), &end);
+        if (end != literal.c_str() + literal.size()) fail("Invalid JSON number");
+        return Json(value);
+    }
+
+    unsigned readHex4() {
+        if (pos_ + 4 > text_.size()) fail("Truncated unicode escape");
+        unsigned code = 0;
+        for (int i = 0; i < 4; ++i) {
+            char ch = text_[pos_++];
+            code <<= 4;
+            if (ch >= '0' && ch <= '9') code |= ch - '0';
+            else if (ch >= 'a' && ch <= 'f') code |= ch - 'a' + 10;
+            else if (ch >= 'A' && ch <= 'F') code |= ch - 'A' + 10;
+            else fail("Invalid unicode escape");
+        }
+        return code;
+    }
+
+    static void appendUtf8(std::string& out, unsigned code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    std::string readString() {
+        pos_++; // opening quote
+        std::string out;
+        while (true) {
+            if (pos_ >= text_.size()) fail("Unterminated JSON string");
+            char ch = text_[pos_++];
+            if (ch == '"') break;
+            if (ch != '\\') {
+                out += ch;
+                continue;
+            }
+            if (pos_ >= text_.size()) fail("Unterminated JSON escape");
+            char escape = text_[pos_++];
+            switch (escape) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned code = readHex4();
+                    if (code >= 0xD800 && code <= 0xDBFF && consumeLiteral("\\u")) {
+                        unsigned low = readHex4();
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default: fail("Invalid JSON escape");
+            }
+        }
+        return out;
+    }
+};
+
+void dumpString(const std::string& value, std::string& out) {
+    out += '"';
+    for (char ch : value) {
+        switch (ch) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+                    out += buffer;
+                } else {
+                    out += ch;
+                }
+        }
+    }
+    out += '"';
+}
+
+const Json kNull;
+const std::string kEmptyString;
+const Json::Array kEmptyArray;
+const Json::Object kEmptyObject;
+
+} // namespace
+
+Json Json::parse(std::string_view text) {
+    return JsonReader(text).readDocument();
+}
+
+std::string Json::dump() const {
+    std::string out;
+    dump(out);
+    return out;
+}
+
+void Json::dump(std::string& out) const {
+    if (isNull()) {
+        out += "null";
+    } else if (isBool()) {
+        out += std::get<bool>(value_) ? "true" : "false";
+    } else if (isNumber()) {
+        double number = std::get<double>(value_);
+        if (std::isfinite(number) && number == std::floor(number) && std::fabs(number) < 9007199254740992.0) {
+            out += std::to_string(static_cast<long long>(number));
+        } else if (std::isfinite(number)) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.17g", number);
+            out += buffer;
+        } else {
+            out += "null";
+        }
+    } else if (isString()) {
+        dumpString(std::get<std::string>(value_), out);
+    } else if (isArray()) {
+        out += '[';
+        bool first = true;
+        for (const auto& element : std::get<Array>(value_)) {
+            if (!first) out += ',';
+            first = false;
+            element.dump(out);
+        }
+        out += ']';
+    } else {
+        out += '{';
+        bool first = true;
+        for (const auto& [key, member] : std::get<Object>(value_)) {
+            if (!first) out += ',';
+            first = false;
+            dumpString(key, out);
+            out += ':';
+            member.dump(out);
+        }
+        out += '}';
+    }
+}
+
+bool Json::asBool(bool fallback) const {
+    return isBool() ? std::get<bool>(value_) : fallback;
+}
+
+double Json::asNumber(double fallback) const {
+    return isNumber() ? std::get<double>(value_) : fallback;
+}
+
+int Json::asInt(int fallback) const {
+    // Converting a double outside int range is undefined; NaN fails too
+    if (!isNumber()) return fallback;
+    double value = std::get<double>(value_);
+    if (!(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max())) {
+        return fallback;
+    }
+    return static_cast<int>(value);
+}
+
+const std::string& Json::asString() const {
+    return isString() ? std::get<std::string>(value_) : kEmptyString;
+}
+
+const Json::Array& Json::asArray() const {
+    return isArray() ? std::get<Array>(value_) : kEmptyArray;
+}
+
+const Json::Object& Json::asObject() const {
+    return isObject() ? std::get<Object>(value_) : kEmptyObject;
+}
+
+const Json& Json::operator[](std::string_view key) const {
+    for (const auto& [name, member] : asObject()) {
+        if (name == key) return member;
+    }
+    return kNull;
+}
+
+bool Json::contains(std::string_view key) const {
+    for (const auto& member : asObject()) {
+        if (member.first == key) return true;
+    }
+    return false;
+}
+
+Json& Json::set(std::string key, Json value) {
+    if (isNull()) value_ = Object{};
+    std::get<Object>(value_).emplace_back(std::move(key), std::move(value));
+    return *this;
+}
+
+Json& Json::push(Json value) {
+    if (isNull()) value_ = Array{};
+    std::get<Array>(value_).push_back(std::move(value));
+    return *this;
+}
+
+} // namespace novasyntax::lsp
@@ -0,0 +1,47 @@
+#include "../../include/lsp/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace novasyntax::lsp {
+
+void LatencyHistogram::record(std::chrono::nanoseconds elapsed) {
+    uint64_t ns = static_cast<uint64_t>(std::max<int64_t>(0, elapsed.count()));
+    uint64_t micros = ns / 1000;
+
+    size_t bucket = 0;
+    while (micros > 0 && bucket + 1 < kBuckets) {
+        micros >>= 1;
+        bucket++;
+    }
+
+    buckets_[bucket]++;
+    count_++;
+    total_ns_ += ns;
+    max_ns_ = std::max(max_ns_, ns);
+}
+
+double LatencyHistogram::meanMicros() const {
+    if (count_ == 0) return 0.0;
+    return static_cast<double>(total_ns_) / static_cast<double>(count_) / 1000.0;
+}
+
+double LatencyHistogram::percentileMicros(double quantile) const {
+    if (count_ == 0) return 0.0;
+    uint64_t rank = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count_)));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+        seen += buckets_[bucket];
+        if (seen >= rank) {
+            return std::min(bucketUpperMicros(bucket), maxMicros());
+        }
+    }
+    return maxMicros();
+}
+
+double LatencyHistogram::bucketUpperMicros(size_t bucket) {
+    return std::ldexp(1.0, static_cast<int>(bucket));
+}
+
+} // namespace novasyntax::lsp
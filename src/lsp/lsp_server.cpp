@@ -0,0 +1,578 @@
+#include "../../include/lsp/lsp_server.h"
+#include <algorithm>
+#include <charconv>
+#include <iomanip>
+#include <stdexcept>
+
+namespace novasyntax::lsp {
+
+namespace {
+
+// JSON-RPC error codes
+constexpr int kParseError = -32700;
+constexpr int kInvalidRequest = -32600;
+constexpr int kMethodNotFound = -32601;
+constexpr int kInternalError = -32603;
+
+// Larger messages are dropped rather than buffered
+constexpr size_t kMaxContentLength = 64 * 1024 * 1024;
+
+// Text sync kind advertised to clients: ranges of changed text
+constexpr int kTextDocumentSyncIncremental = 2;
+
+// Waits are bounded and re-check their predicate on every wake-up
+constexpr std::chrono::milliseconds kWaitSlice{50};
+
+// Byte offset of a protocol position. Characters are counted as bytes,
+// which matches UTF-16 columns for the ASCII sources NovaSyntax accepts.
+size_t offsetOf(const std::string& text, int line, int character) {
+    size_t offset = 0;
+    for (int current = 0; current < line && offset < text.size(); ++current) {
+        size_t newline = text.find('\n', offset);
+        if (newline == std::string::npos) return text.size();
+        offset = newline + 1;
+    }
+    size_t line_end = text.find('\n', offset);
+    if (line_end == std::string::npos) line_end = text.size();
+    return std::min(offset + static_cast<size_t>(std::max(0, character)), line_end);
+}
+
+Json position(int line, int character) {
+    Json result;
+    result.set("line", line);
+    result.set("character", character);
+    return result;
+}
+
+Json range(int line, int column, int length) {
+    Json result;
+    result.set("start", position(line, column));
+    result.set("end", position(line, column + length));
+    return result;
+}
+
+Json toJsonArray(const std::vector<uint32_t>& data, size_t begin, size_t end) {
+    Json::Array array;
+    array.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        array.emplace_back(static_cast<unsigned long>(data[i]));
+    }
+    return Json(std::move(array));
+}
+
+} // namespace
+
+LspServer::LspServer(std::istream& in, std::ostream& out, std::ostream& log)
+    : in_(in), out_(out), log_(log) {}
+
+LspServer::~LspServer() {
+    stopWorker();
+}
+
+int LspServer::run() {
+    worker_ = std::thread(&LspServer::workerLoop, this);
+
+    std::string body;
+    while (readMessage(body)) {
+        Json message;
+        try {
+            message = Json::parse(body);
+        } catch (const std::runtime_error& e) {
+            sendError(nullptr, kParseError, e.what());
+            continue;
+        }
+        if (!handleMessage(message)) {
+            break;
+        }
+    }
+
+    stopWorker();
+    writeLatencyReport();
+    return shutdown_requested_ ? 0 : 1;
+}
+
+bool LspServer::readMessage(std::string& body) {
+    while (true) {
+        size_t content_length = 0;
+        bool has_length = false;
+        std::string header;
+
+        while (std::getline(in_, header)) {
+            if (!header.empty() && header.back() == '\r') {
+                header.pop_back();
+            }
+            if (header.empty()) {
+                if (has_length) break;
+                continue;
+            }
+
+            // Found anywhere in the line: the unframed body of a dropped
+            // message may run into the next header
+            const std::string prefix = "Content-Length:";
+            size_t at = header.find(prefix);
+            if (at != std::string::npos) {
+                has_length = parseContentLength(header.substr(at + prefix.size()), content_length);
+            }
+        }
+        if (!has_length || !in_) {
+            return false;
+        }
+
+        if (content_length > kMaxContentLength) {
+            // The length is still good for framing, so skip just this body
+            in_.ignore(static_cast<std::streamsize>(content_length));
+            log_ << "novasyntax-lsp: dropped message of " << content_length << " bytes" << std::endl;
+            sendError(nullptr, kInvalidRequest, "Message exceeds " + std::to_string(kMaxContentLength) + " bytes");
+            continue;
+        }
+
+        body.resize(content_length);
+        in_.read(body.data(), static_cast<std::streamsize>(content_length));
+        return static_cast<size_t>(in_.gcount()) == content_length;
+    }
+}
+
+bool LspServer::parseContentLength(const std::string& value, size_t& length) {
+    size_t begin = std::min(value.find_first_not_of(" \t"), value.size());
+    size_t end = value.find_last_not_of(" \t") + 1;
+    const char* first = value.data() + begin;
+    const char* last = value.data() + std::max(begin, end);
+    auto [ptr, ec] = std::from_chars(first, last, length);
+    if (first != last && ec == std::errc() && ptr == last) return true;
+
+    // Without a length the body cannot be found; the next header resyncs
+    log_ << "novasyntax-lsp: invalid Content-Length '" << std::string(first, last) << "'" << std::endl;
+    sendError(nullptr, kInvalidRequest, "Invalid Content-Length header");
+    return false;
+}
+
+void LspServer::writeMessage(const Json& message) {
+    std::string body = message.dump();
+    std::lock_guard<std::mutex> lock(out_mutex_);
+    out_ << "Content-Length: " << body.size() << "\r\n\r\n" << body;
+    out_.flush();
+}
+
+void LspServer::sendResponse(const Json& id, Json result) {
+    Json response;
+    response.set("jsonrpc", "2.0");
+    response.set("id", id);
+    response.set("result", std::move(result));
+    writeMessage(response);
+}
+
+void LspServer::sendError(const Json& id, int code, const std::string& message) {
+    Json error;
+    error.set("code", code);
+    error.set("message", message);
+
+    Json response;
+    response.set("jsonrpc", "2.0");
+    response.set("id", id);
+    response.set("error", std::move(error));
+    writeMessage(response);
+}
+
+bool LspServer::handleMessage(const Json& message) {
+    const std::string& method = message["method"].asString();
+    if (method.empty()) {
+        // Responses to server-initiated requests; none are sent
+        return true;
+    }
+    if (method == "exit") {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const Json& params = message["params"];
+
+    if (message.contains("id")) {
+        const Json& id = message["id"];
+        try {
+            Json result;
+            if (handleRequest(method, params, result)) {
+                sendResponse(id, std::move(result));
+            } else {
+                sendError(id, kMethodNotFound, "Unhandled method: " + method);
+            }
+        } catch (const std::exception& e) {
+            sendError(id, kInternalError, e.what());
+        }
+    } else {
+        try {
+            handleNotification(method, params);
+        } catch (const std::exception& e) {
+            log_ << "novasyntax-lsp: " << method << ": " << e.what() << std::endl;
+        }
+    }
+
+    recordLatency(method, std::chrono::steady_clock::now() - start);
+    return true;
+}
+
+bool LspServer::handleRequest(const std::string& method, const Json& params, Json& result) {
+    if (method == "initialize") {
+        result = initializeResult();
+    } else if (method == "shutdown") {
+        shutdown_requested_ = true;
+        result = nullptr;
+    } else if (method == "textDocument/semanticTokens/full") {
+        result = semanticTokensFull(params);
+    } else if (method == "textDocument/semanticTokens/full/delta") {
+        result = semanticTokensDelta(params);
+    } else if (method == "textDocument/definition") {
+        result = definition(params);
+    } else if (method == "novasyntax/latencyStats") {
+        result = latencyStats();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void LspServer::handleNotification(const std::string& method, const Json& params) {
+    if (method == "textDocument/didOpen") {
+        didOpen(params);
+    } else if (method == "textDocument/didChange") {
+        didChange(params);
+    } else if (method == "textDocument/didClose") {
+        didClose(params);
+    }
+    // 'initialized', '$/cancelRequest' and unknown notifications are ignored;
+    // requests are answered in order, so there is nothing left to cancel
+}
+
+Json LspServer::initializeResult() const {
+    Json legend_types;
+    for (const auto& type : semanticTokenTypes()) legend_types.push(type);
+    Json legend_modifiers;
+    for (const auto& modifier : semanticTokenModifiers()) legend_modifiers.push(modifier);
+
+    Json legend;
+    legend.set("tokenTypes", std::move(legend_types));
+    legend.set("tokenModifiers", std::move(legend_modifiers));
+
+    Json full;
+    full.set("delta", true);
+
+    Json semantic_tokens;
+    semantic_tokens.set("legend", std::move(legend));
+    semantic_tokens.set("full", std::move(full));
+
+    Json sync;
+    sync.set("openClose", true);
+    sync.set("change", kTextDocumentSyncIncremental);
+
+    Json capabilities;
+    capabilities.set("textDocumentSync", std::move(sync));
+    capabilities.set("semanticTokensProvider", std::move(semantic_tokens));
+    capabilities.set("definitionProvider", true);
+
+    Json server_info;
+    server_info.set("name", "novasyntax");
+    server_info.set("version", "0.1.0");
+
+    Json result;
+    result.set("capabilities", std::move(capabilities));
+    result.set("serverInfo", std::move(server_info));
+    return result;
+}
+
+void LspServer::didOpen(const Json& params) {
+    const Json& item = params["textDocument"];
+    const std::string& uri = item["uri"].asString();
+
+    Document& document = documents_[uri];
+    document.text = item["text"].asString();
+    document.version = item["version"].asInt();
+    document.revision = next_revision_++;
+    scheduleAnalysis(uri);
+}
+
+void LspServer::didChange(const Json& params) {
+    const Json& item = params["textDocument"];
+    const std::string& uri = item["uri"].asString();
+
+    auto it = documents_.find(uri);
+    if (it == documents_.end()) {
+        throw std::runtime_error("didChange for unopened document " + uri);
+    }
+    Document& document = it->second;
+
+    for (const auto& change : params["contentChanges"].asArray()) {
+        if (!change.contains("range")) {
+            document.text = change["text"].asString();
+            continue;
+        }
+        const Json& start = change["range"]["start"];
+        const Json& end = change["range"]["end"];
+        size_t from = offsetOf(document.text, start["line"].asInt(), start["character"].asInt());
+        size_t to = offsetOf(document.text, end["line"].asInt(), end["character"].asInt());
+        if (to < from) std::swap(from, to);
+        document.text.replace(from, to - from, change["text"].asString());
+    }
+
+    document.version = item["version"].asInt(document.version + 1);
+    document.revision = next_revision_++;
+    scheduleAnalysis(uri);
+}
+
+void LspServer::didClose(const Json& params) {
+    const std::string& uri = params["textDocument"]["uri"].asString();
+    cancelAnalysis(uri);
+    documents_.erase(uri);
+    semantic_results_.erase(uri);
+
+    // Clear the client's diagnostics for the closed document
+    publishDiagnostics(uri, DocumentAnalysis{});
+}
+
+Json LspServer::semanticTokensFull(const Json& params) {
+    const std::string& uri = params["textDocument"]["uri"].asString();
+    auto analysis = currentAnalysis(uri);
+    if (!analysis) return nullptr;
+
+    SemanticTokensResult& stored = semantic_results_[uri];
+    stored.result_id = std::to_string(next_result_id_++);
+    stored.data = analysis->semantic_tokens;
+
+    Json result;
+    result.set("resultId", stored.result_id);
+    result.set("data", toJsonArray(stored.data, 0, stored.data.size()));
+    return result;
+}
+
+Json LspServer::semanticTokensDelta(const Json& params) {
+    const std::string& uri = params["textDocument"]["uri"].asString();
+    auto stored = semantic_results_.find(uri);
+    if (stored == semantic_results_.end() ||
+        stored->second.result_id != params["previousResultId"].asString()) {
+        return semanticTokensFull(params);
+    }
+
+    auto analysis = currentAnalysis(uri);
+    if (!analysis) return nullptr;
+
+    // A single edit replacing everything between the common prefix and suffix
+    const std::vector<uint32_t>& previous = stored->second.data;
+    const std::vector<uint32_t>& current = analysis->semantic_tokens;
+    size_t limit = std::min(previous.size(), current.size());
+    size_t prefix = 0;
+    while (prefix < limit && previous[prefix] == current[prefix]) prefix++;
+    size_t suffix = 0;
+    while (suffix < limit - prefix &&
+           previous[previous.size() - 1 - suffix] == current[current.size() - 1 - suffix]) {
+        suffix++;
+    }
+
+    Json edits = Json::Array{};
+    if (prefix != previous.size() || previous.size() != current.size()) {
+        Json edit;
+        edit.set("start", static_cast<unsigned long>(prefix));
+        edit.set("deleteCount", static_cast<unsigned long>(previous.size() - prefix - suffix));
+        edit.set("data", toJsonArray(current, prefix, current.size() - suffix));
+        edits.push(std::move(edit));
+    }
+
+    stored->second.result_id = std::to_string(next_result_id_++);
+    stored->second.data = current;
+
+    Json result;
+    result.set("resultId", stored->second.result_id);
+    result.set("edits", std::move(edits));
+    return result;
+}
+
+Json LspServer::definition(const Json& params) {
+    const std::string& uri = params["textDocument"]["uri"].asString();
+    auto analysis = currentAnalysis(uri);
+    if (!analysis) return nullptr;
+
+    const Json& at = params["position"];
+    int index = symbolAt(*analysis, at["line"].asInt(), at["character"].asInt());
+    if (index < 0 || analysis->symbols[index].definition < 0) return nullptr;
+
+    const Symbol& target = analysis->symbols[analysis->symbols[index].definition];
+    Json location;
+    location.set("uri", uri);
+    location.set("range", range(target.line, target.column, target.length));
+    return location;
+}
+
+Json LspServer::latencyStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Json methods;
+    for (const auto& [name, histogram] : latency_) {
+        size_t used = histogram.buckets().size();
+        while (used > 0 && histogram.buckets()[used - 1] == 0) used--;
+        Json buckets = Json::Array{};
+        for (size_t i = 0; i < used; ++i) {
+            buckets.push(static_cast<unsigned long>(histogram.buckets()[i]));
+        }
+
+        Json stats;
+        stats.set("count", static_cast<unsigned long>(histogram.count()));
+        stats.set("meanMicros", histogram.meanMicros());
+        stats.set("p50Micros", histogram.percentileMicros(0.50));
+        stats.set("p90Micros", histogram.percentileMicros(0.90));
+        stats.set("p99Micros", histogram.percentileMicros(0.99));
+        stats.set("maxMicros", histogram.maxMicros());
+        stats.set("buckets", std::move(buckets));
+        methods.set(name, std::move(stats));
+    }
+
+    Json result;
+    result.set("methods", methods.isNull() ? Json(Json::Object{}) : std::move(methods));
+    result.set("cancelledAnalyses", static_cast<unsigned long>(cancelled_analyses_));
+    return result;
+}
+
+void LspServer::scheduleAnalysis(const std::string& uri) {
+    const Document& document = documents_[uri];
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_uri_ == uri && running_cancelled_) {
+        running_cancelled_->store(true);
+    }
+    // Replacing the pending job drops any older, not yet started version
+    pending_[uri] = Job{uri, document.text, document.version, document.revision,
+                        std::make_shared<std::atomic<bool>>(false)};
+    work_cv_.notify_one();
+}
+
+void LspServer::cancelAnalysis(const std::string& uri) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_uri_ == uri && running_cancelled_) {
+        running_cancelled_->store(true);
+    }
+    pending_.erase(uri);
+    analyses_.erase(uri);
+}
+
+std::shared_ptr<const DocumentAnalysis> LspServer::currentAnalysis(const std::string& uri) {
+    auto document = documents_.find(uri);
+    if (document == documents_.end()) return nullptr;
+    uint64_t revision = document->second.revision;
+
+    // The latest revision is always pending or running, so this wait ends
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto ready = [&] {
+        auto it = analyses_.find(uri);
+        return stopping_ || (it != analyses_.end() && it->second.revision >= revision);
+    };
+    while (!analysis_cv_.wait_for(lock, kWaitSlice, ready)) {
+    }
+
+    auto it = analyses_.find(uri);
+    return it != analyses_.end() ? it->second.analysis : nullptr;
+}
+
+void LspServer::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        auto has_work = [&] { return stopping_ || !pending_.empty(); };
+        while (!work_cv_.wait_for(lock, kWaitSlice, has_work)) {
+        }
+        if (pending_.empty()) {
+            return; // Stopping with nothing left to drain
+        }
+
+        Job job = std::move(pending_.begin()->second);
+        pending_.erase(pending_.begin());
+        running_uri_ = job.uri;
+        running_cancelled_ = job.cancelled;
+        lock.unlock();
+
+        auto analysis = std::make_shared<DocumentAnalysis>();
+        analysis->version = job.version;
+        auto start = std::chrono::steady_clock::now();
+        bool complete = analyzeDocument(job.text, *job.cancelled, *analysis);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        lock.lock();
+        running_uri_.clear();
+        running_cancelled_.reset();
+
+        if (!complete || job.cancelled->load()) {
+            cancelled_analyses_++;
+            latency_["analysis (cancelled)"].record(elapsed);
+            continue;
+        }
+        latency_["analysis"].record(elapsed);
+        analyses_[job.uri] = CompletedAnalysis{job.revision, analysis};
+        analysis_cv_.notify_all();
+
+        // Published under the lock, so a didClose cannot slip in between and
+        // have its cleared diagnostics overwritten by these. Skipped if a
+        // newer revision is already queued.
+        if (pending_.find(job.uri) == pending_.end()) {
+            publishDiagnostics(job.uri, *analysis);
+        }
+    }
+}
+
+void LspServer::publishDiagnostics(const std::string& uri, const DocumentAnalysis& analysis) {
+    Json diagnostics = Json::Array{};
+    for (const auto& diagnostic : analysis.diagnostics) {
+        Json item;
+        item.set("range", range(diagnostic.line, diagnostic.column, diagnostic.length));
+        item.set("severity", 1);
+        item.set("source", "novasyntax");
+        item.set("message", diagnostic.message);
+        diagnostics.push(std::move(item));
+    }
+
+    Json params;
+    params.set("uri", uri);
+    if (analysis.version > 0) {
+        params.set("version", analysis.version);
+    }
+    params.set("diagnostics", std::move(diagnostics));
+
+    Json notification;
+    notification.set("jsonrpc", "2.0");
+    notification.set("method", "textDocument/publishDiagnostics");
+    notification.set("params", std::move(params));
+    writeMessage(notification);
+}
+
+void LspServer::recordLatency(const std::string& name, std::chrono::nanoseconds elapsed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latency_[name].record(elapsed);
+}
+
+void LspServer::stopWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    analysis_cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void LspServer::writeLatencyReport() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (latency_.empty()) return;
+
+    log_ << "novasyntax-lsp latency (microseconds)\n";
+    log_ << std::left << std::setw(40) << "method" << std::right
+         << std::setw(8) << "count" << std::setw(12) << "mean"
+         << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "max" << "\n";
+    for (const auto& [name, histogram] : latency_) {
+        log_ << std::left << std::setw(40) << name << std::right
+             << std::setw(8) << histogram.count()
+             << std::fixed << std::setprecision(1)
+             << std::setw(12) << histogram.meanMicros()
+             << std::setw(12) << histogram.percentileMicros(0.50)
+             << std::setw(12) << histogram.percentileMicros(0.99)
+             << std::setw(12) << histogram.maxMicros() << "\n";
+    }
+    log_.flush();
+}
+
+} // namespace novasyntax::lsp
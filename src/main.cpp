@@ -1,8 +1,20 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <stdexcept>
+#include <string>
+#include <vector>
+#include "codegen/c_backend.h"
+#include "format/formatter.h"
 #include "lexer.hpp"
+#include "lsp/lsp_server.h"
+#include "semantic/type_inference.h"
 
-int main() {
+namespace {
+
+int runLexerDemo() {
     std::string source = R"(
         func calculate(x, y) {
             let result = x + y
@@ -30,3 +42,216 @@ int main() {
 
     return 0;
 }
+
+bool readFile(const std::string& path, std::string& contents) {
+    // Read in chunks rather than by size: pipes have no size to ask for
+    std::error_code ec;
+    if (std::filesystem::is_directory(path, ec)) return false;
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    contents.clear();
+    char buffer[1 << 16];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+        contents.append(buffer, static_cast<size_t>(file.gcount()));
+    }
+    return !file.bad();
+}
+
+bool writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    return static_cast<bool>(file);
+}
+
+// novasyntax fmt [--check | -w] [files...]
+//   no files  format stdin to stdout
+//   --check   list files that are not formatted; exit 1 if there are any
+//   -w        rewrite files in place
+int runFormatter(int argc, char* argv[]) {
+    bool check = false;
+    bool write = false;
+    std::vector<std::string> paths;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--check") {
+            check = true;
+        } else if (arg == "-w" || arg == "--write") {
+            write = true;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    novasyntax::Formatter formatter;
+    std::string source;
+    std::string formatted;
+    std::string error;
+
+    if (paths.empty()) {
+        source.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+        if (!formatter.formatSource(source, formatted, error)) {
+            std::cerr << "<stdin>: " << error << std::endl;
+            return 1;
+        }
+        if (check) return formatted == source ? 0 : 1;
+        std::cout << formatted;
+        return 0;
+    }
+
+    int status = 0;
+    for (const auto& path : paths) {
+        if (!readFile(path, source)) {
+            std::cerr << path << ": cannot read file" << std::endl;
+            status = 1;
+            continue;
+        }
+        if (!formatter.formatSource(source, formatted, error)) {
+            std::cerr << path << ": " << error << std::endl;
+            status = 1;
+            continue;
+        }
+
+        if (check) {
+            if (formatted != source) {
+                std::cout << path << "\n";
+                status = 1;
+            }
+        } else if (write) {
+            if (formatted != source && !writeFile(path, formatted)) {
+                std::cerr << path << ": cannot write file" << std::endl;
+                status = 1;
+            }
+        } else {
+            std::cout << formatted;
+        }
+    }
+    return status;
+}
+
+// Output path for `build`: the source path with its extension replaced
+std::string sharedObjectPath(const std::string& source) {
+    size_t slash = source.find_last_of('/');
+    size_t dot = source.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return source + ".so";
+    }
+    return source.substr(0, dot) + ".so";
+}
+
+// novasyntax build <file> [-o <output.so>] [--emit-c <output.c>]
+//   Lower the file's numeric functions to C and compile them into a shared
+//   object with the system C compiler ($CC, or cc)
+int runBuild(int argc, char* argv[]) {
+    std::string input;
+    std::string output;
+    std::string c_output;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "-o" || arg == "--emit-c") && i + 1 < argc) {
+            (arg == "-o" ? output : c_output) = argv[++i];
+        } else if (input.empty()) {
+            input = arg;
+        } else {
+            std::cerr << "build: unexpected argument '" << arg << "'" << std::endl;
+            return 1;
+        }
+    }
+    if (input.empty()) {
+        std::cerr << "build: no input file" << std::endl;
+        return 1;
+    }
+    if (output.empty()) output = sharedObjectPath(input);
+
+    std::string source;
+    if (!readFile(input, source)) {
+        std::cerr << input << ": cannot read file" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<novasyntax::ASTNode>> program;
+    try {
+        novasyntax::Lexer lexer(source);
+        novasyntax::Parser parser(lexer.tokenize(), false);
+        program = parser.parseProgram();
+        for (const auto& error : parser.errors()) {
+            std::cerr << input << ":" << error.line << ":" << error.column << ": " << error.message << "\n";
+        }
+        if (parser.hadError()) return 1;
+    } catch (const std::runtime_error& e) {
+        std::cerr << input << ": " << e.what() << std::endl;
+        return 1;
+    }
+
+    novasyntax::TypeInference inference;
+    auto type_errors = inference.run(program);
+    for (const auto& error : type_errors) {
+        std::cerr << input << ":" << error.line << ":" << error.column << ": " << error.message << "\n";
+    }
+    if (!type_errors.empty()) return 1;
+
+    novasyntax::CBackend backend;
+    const std::string& c_source = backend.emit(program, input);
+    for (const auto& skipped : backend.skipped()) {
+        std::cerr << input << ":" << skipped.line << ": note: '" << skipped.name
+                  << "' is not compiled: it " << skipped.reason << "\n";
+    }
+
+    std::string c_path = c_output.empty() ? output + ".c" : c_output;
+    if (!writeFile(c_path, c_source)) {
+        std::cerr << c_path << ": cannot write file" << std::endl;
+        return 1;
+    }
+    std::string error;
+    bool compiled = novasyntax::compileSharedObject(c_path, output, error);
+    if (c_output.empty()) std::remove(c_path.c_str());
+    if (!compiled) {
+        std::cerr << "build: " << error << std::endl;
+        return 1;
+    }
+
+    std::cout << output << ": " << backend.lowered().size() << " native function(s)";
+    for (size_t i = 0; i < backend.lowered().size(); ++i) {
+        std::cout << (i == 0 ? ": " : ", ") << backend.lowered()[i].name;
+    }
+    std::cout << "\n";
+    return 0;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--lsp | fmt [--check | -w] [files...] | build <file> [-o <out.so>]]\n"
+              << "  (no arguments)  Run the lexer demo\n"
+              << "  --lsp           Serve the Language Server Protocol over stdin/stdout\n"
+              << "  fmt             Format source files (stdin if none are given)\n"
+              << "  build           Compile numeric functions to a native shared object\n"
+              << "                  (--emit-c <file> keeps the generated C)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        return runLexerDemo();
+    }
+
+    std::string command = argv[1];
+    if (command == "--lsp") {
+        // stdout carries the protocol; everything else goes to stderr
+        std::ios::sync_with_stdio(false);
+        novasyntax::lsp::LspServer server(std::cin, std::cout, std::cerr);
+        return server.run();
+    }
+
+    if (command == "fmt") {
+        return runFormatter(argc, argv);
+    }
+
+    if (command == "build") {
+        return runBuild(argc, argv);
+    }
+
+    printUsage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,114 @@
+#include "../../include/parser/flat_ast.h"
+#include "../../include/parser/ast_visitor.h"
+#include <algorithm>
+
+namespace novasyntax {
+
+namespace {
+
+// Emits each node after its children, so the output is in post-order
+class FlatAstBuilder : public AstVisitor<FlatAstBuilder, bool> {
+public:
+    explicit FlatAstBuilder(std::vector<FlatNode>& nodes) : nodes_(nodes) {}
+
+    // Each visit returns true if it emitted a node
+    bool visitExpression(const Expression& expr) {
+        FlatNodeKind kind = FlatNodeKind::NUMBER;
+        switch (expr.type) {
+            case Expression::Type::LITERAL: kind = FlatNodeKind::NUMBER; break;
+            case Expression::Type::STRING_LITERAL: kind = FlatNodeKind::STRING; break;
+            case Expression::Type::IDENTIFIER: kind = FlatNodeKind::IDENTIFIER; break;
+            case Expression::Type::BINARY: kind = FlatNodeKind::BINARY; break;
+            case Expression::Type::CALL: kind = FlatNodeKind::CALL; break;
+        }
+
+        uint32_t begin = size();
+        uint32_t children = 0;
+        if (kind == FlatNodeKind::BINARY) {
+            children += emit(expr.left.get());
+            children += emit(expr.right.get());
+        } else if (kind == FlatNodeKind::CALL) {
+            for (const auto& argument : expr.arguments) {
+                children += emit(argument.get());
+            }
+        }
+        add(kind, expr.value, expr, begin, children).op = static_cast<uint8_t>(expr.op);
+        return true;
+    }
+
+    bool visitVariable(const VariableDeclaration& var) {
+        uint32_t begin = size();
+        uint32_t children = emit(var.initializer.get());
+        add(FlatNodeKind::VARIABLE, var.name, var, begin, children);
+        return true;
+    }
+
+    bool visitFunction(const FunctionDeclaration& func) {
+        uint32_t begin = size();
+        uint32_t children = 0;
+        for (size_t i = 0; i < func.parameters.size(); ++i) {
+            FlatNode& param = add(FlatNodeKind::PARAMETER, func.parameters[i], func, size(), 0);
+            ValueType type = i < func.parameter_types.size() ? func.parameter_types[i] : ValueType::UNKNOWN;
+            param.value_type = static_cast<uint8_t>(type);
+            param.extra = static_cast<uint32_t>(i);
+            children++;
+        }
+        for (const auto& statement : func.statements) {
+            children += emit(statement.get());
+        }
+        bool has_body = emit(func.body.get());
+        children += has_body;
+
+        FlatNode& node = add(FlatNodeKind::FUNCTION, func.name, func, begin, children);
+        node.flags = has_body ? kFlatNodeHasBody : 0;
+        node.extra = static_cast<uint32_t>(func.parameters.size());
+        return true;
+    }
+
+    bool emit(const ASTNode* node) { return node && visit(*node); }
+
+private:
+    std::vector<FlatNode>& nodes_;
+
+    uint32_t size() const { return static_cast<uint32_t>(nodes_.size()); }
+
+    FlatNode& add(FlatNodeKind kind, std::string_view value, const ASTNode& source,
+                  uint32_t subtree_begin, uint32_t child_count) {
+        FlatNode node{};
+        node.kind = kind;
+        node.op = static_cast<uint8_t>(TokenType::EOF_);
+        node.value_type = static_cast<uint8_t>(source.inferred_type);
+        node.child_count = child_count;
+        node.subtree_size = size() - subtree_begin + 1;
+        node.value = value;
+        node.source = &source;
+        nodes_.push_back(node);
+        return nodes_.back();
+    }
+};
+
+} // namespace
+
+void FlatAst::build(const std::vector<std::unique_ptr<ASTNode>>& program) {
+    nodes_.clear();
+    roots_.clear();
+
+    FlatAstBuilder builder(nodes_);
+    for (const auto& node : program) {
+        if (builder.emit(node.get())) {
+            roots_.push_back(static_cast<uint32_t>(nodes_.size() - 1));
+        }
+    }
+}
+
+void FlatAst::children(uint32_t index, std::vector<uint32_t>& out) const {
+    out.clear();
+    uint32_t child = index;
+    for (uint32_t i = 0; i < nodes_[index].child_count; ++i) {
+        child -= i == 0 ? 1 : nodes_[child].subtree_size;
+        out.push_back(child);
+    }
+    std::reverse(out.begin(), out.end());
+}
+
+} // namespace novasyntax
@@ -5,8 +5,10 @@
 
 namespace novasyntax {
 
-Parser::Parser(const std::vector<Token>& tokens) : tokens_(tokens) {
-    std::cout << "Parser initialized with " << tokens.size() << " tokens\n";
+Parser::Parser(const std::vector<Token>& tokens, bool trace) : tokens_(tokens), trace_(trace) {
+    if (trace_) {
+        std::cout << "Parser initialized with " << tokens.size() << " tokens\n";
+    }
     if (tokens_.empty()) {
         throw std::runtime_error("Cannot parse empty token stream");
     }
@@ -15,35 +17,59 @@ Parser::Parser(const std::vector<Token>& tokens) : tokens_(tokens) {
 std::unique_ptr<ASTNode> Parser::parse() {
     try {
         if (is_at_end()) {
-            std::cerr << "Reached end of token stream\n";
+            if (trace_) std::cerr << "Reached end of token stream\n";
             return nullptr;
         }
 
-        std::cout << "Parsing first token: " 
-                  << "Type=" << static_cast<int>(peek().type) 
-                  << ", Literal='" << peek().literal << "'\n";
+        if (trace_) {
+            std::cout << "Parsing first token: "
+                      << "Type=" << static_cast<int>(peek().type)
+                      << ", Literal='" << peek().literal << "'\n";
+        }
 
         if (peek().type == TokenType::FUNCTION) {
-            std::cout << "Parsing function declaration\n";
+            if (trace_) std::cout << "Parsing function declaration\n";
             return parseFunctionDeclaration();
         }
         if (peek().type == TokenType::LET) {
-            std::cout << "Parsing variable declaration\n";
+            if (trace_) std::cout << "Parsing variable declaration\n";
             return parseVariableDeclaration();
         }
-        std::cout << "Parsing expression\n";
+        if (trace_) std::cout << "Parsing expression\n";
         return parseExpression();
     } catch (const std::runtime_error& e) {
-        std::cerr << "Parsing error: " << e.what() << std::endl;
+        reportError("Parsing error", e.what());
         return nullptr;
     } catch (...) {
-        std::cerr << "Unknown parsing error occurred\n";
+        reportError("Parsing error", "Unknown parsing error occurred");
         return nullptr;
     }
 }
 
+std::vector<std::unique_ptr<ASTNode>> Parser::parseProgram() {
+    std::vector<std::unique_ptr<ASTNode>> program;
+
+    while (!is_at_end()) {
+        size_t start = current_token_;
+        auto node = parse();
+
+        if (node) {
+            program.push_back(std::move(node));
+        }
+
+        // Guarantee progress on malformed input
+        if (current_token_ == start) {
+            synchronize();
+        }
+    }
+
+    return program;
+}
+
 std::unique_ptr<FunctionDeclaration> Parser::parseFunctionDeclaration() {
     auto func_decl = std::make_unique<FunctionDeclaration>();
+    func_decl->line = peek().line;
+    func_decl->column = peek().column;
 
     try {
         // Consume 'func' keyword
@@ -51,7 +77,7 @@ std::unique_ptr<FunctionDeclaration> Parser::parseFunctionDeclaration() {
 
         // Parse function name
         func_decl->name = consume(TokenType::IDENTIFIER, "Expect function name").literal;
-        std::cout << "Function name: " << func_decl->name << std::endl;
+        if (trace_) std::cout << "Function name: " << func_decl->name << std::endl;
 
         // Consume opening parenthesis
         consume(TokenType::LPAREN, "Expect '(' after function name");
@@ -78,16 +104,41 @@ std::unique_ptr<FunctionDeclaration> Parser::parseFunctionDeclaration() {
         // Consume opening brace
         consume(TokenType::LBRACE, "Expect '{' before function body");
 
-        // Parse function body (simplified for now)
-        // In a full implementation, this would parse statements
-        func_decl->body = parseExpression();
+        // Parse function body: let declarations and expression statements,
+        // ending in an optional 'return' whose operand is the result
+        while (!is_at_end() && peek().type != TokenType::RBRACE) {
+            if (peek().type == TokenType::LET) {
+                auto local = parseVariableDeclaration();
+                if (!local) {
+                    throw std::runtime_error("Invalid variable declaration in function body");
+                }
+                func_decl->statements.push_back(std::move(local));
+                continue;
+            }
+
+            bool is_return = peek().type == TokenType::RETURN;
+            if (is_return) {
+                advance(); // Consume 'return'
+            }
+
+            auto expr = parseExpression();
+            if (!expr) {
+                throw std::runtime_error("Invalid expression in function body");
+            }
+
+            if (is_return || peek().type == TokenType::RBRACE) {
+                func_decl->body = std::move(expr);
+                break;
+            }
+            func_decl->statements.push_back(std::move(expr));
+        }
 
         // Consume closing brace
         consume(TokenType::RBRACE, "Expect '}' after function body");
 
         return func_decl;
     } catch (const std::runtime_error& e) {
-        std::cerr << "Error parsing function declaration: " << e.what() << std::endl;
+        reportError("Error parsing function declaration", e.what());
         return nullptr;
     }
 }
@@ -95,6 +146,8 @@ std::unique_ptr<FunctionDeclaration> Parser::parseFunctionDeclaration() {
 std::unique_ptr<VariableDeclaration> Parser::parseVariableDeclaration() {
     try {
         auto var_decl = std::make_unique<VariableDeclaration>();
+        var_decl->line = peek().line;
+        var_decl->column = peek().column;
 
         // Consume 'let' keyword
         consume(TokenType::LET, "Expect 'let' at the start of variable declaration");
@@ -110,43 +163,106 @@ std::unique_ptr<VariableDeclaration> Parser::parseVariableDeclaration() {
 
         return var_decl;
     } catch (const std::runtime_error& e) {
-        std::cerr << "Error parsing variable declaration: " << e.what() << std::endl;
+        reportError("Error parsing variable declaration", e.what());
         return nullptr;
     }
 }
 
 std::unique_ptr<Expression> Parser::parseExpression() {
     try {
-        auto expr = std::make_unique<Expression>();
-
-        // Simplified expression parsing
-        if (peek().type == TokenType::NUMBER) {
-            expr->type = Expression::Type::LITERAL;
-            expr->value = advance().literal;
-        } else if (peek().type == TokenType::IDENTIFIER) {
-            expr->type = Expression::Type::LITERAL;
-            expr->value = advance().literal;
-        } else if (peek().type == TokenType::STRING) {
-            expr->type = Expression::Type::STRING_LITERAL;
-            expr->value = advance().literal;
-        } else {
-            std::cerr << "Unexpected token type: " 
-                      << static_cast<int>(peek().type) << std::endl;
-            throw std::runtime_error("Unexpected token in expression");
-        }
-
-        return expr;
+        return parseAdditive();
     } catch (const std::runtime_error& e) {
-        std::cerr << "Error parsing expression: " << e.what() << std::endl;
+        reportError("Error parsing expression", e.what());
         return nullptr;
     }
 }
 
+std::unique_ptr<Expression> Parser::parseAdditive() {
+    auto expr = parseMultiplicative();
+
+    while (peek().type == TokenType::PLUS || peek().type == TokenType::MINUS) {
+        auto binary = std::make_unique<Expression>();
+        binary->type = Expression::Type::BINARY;
+        binary->line = expr->line;
+        binary->column = expr->column;
+        binary->op = peek().type;
+        binary->value = advance().literal;
+        binary->left = std::move(expr);
+        binary->right = parseMultiplicative();
+        expr = std::move(binary);
+    }
+
+    return expr;
+}
+
+std::unique_ptr<Expression> Parser::parseMultiplicative() {
+    auto expr = parsePrimary();
+
+    while (peek().type == TokenType::MULTIPLY || peek().type == TokenType::DIVIDE) {
+        auto binary = std::make_unique<Expression>();
+        binary->type = Expression::Type::BINARY;
+        binary->line = expr->line;
+        binary->column = expr->column;
+        binary->op = peek().type;
+        binary->value = advance().literal;
+        binary->left = std::move(expr);
+        binary->right = parsePrimary();
+        expr = std::move(binary);
+    }
+
+    return expr;
+}
+
+std::unique_ptr<Expression> Parser::parsePrimary() {
+    auto expr = std::make_unique<Expression>();
+    expr->line = peek().line;
+    expr->column = peek().column;
+
+    if (peek().type == TokenType::NUMBER) {
+        expr->type = Expression::Type::LITERAL;
+        expr->value = advance().literal;
+    } else if (peek().type == TokenType::STRING) {
+        expr->type = Expression::Type::STRING_LITERAL;
+        expr->value = advance().literal;
+    } else if (peek().type == TokenType::IDENTIFIER) {
+        expr->type = Expression::Type::IDENTIFIER;
+        expr->value = advance().literal;
+
+        // Function call
+        if (peek().type == TokenType::LPAREN) {
+            advance(); // Consume '('
+            expr->type = Expression::Type::CALL;
+            while (!is_at_end() && peek().type != TokenType::RPAREN) {
+                expr->arguments.push_back(parseAdditive());
+                if (peek().type != TokenType::COMMA) {
+                    break;
+                }
+                advance(); // Consume comma
+            }
+            consume(TokenType::RPAREN, "Expect ')' after arguments");
+        }
+    } else if (peek().type == TokenType::LPAREN) {
+        advance(); // Consume '('
+        expr = parseAdditive();
+        consume(TokenType::RPAREN, "Expect ')' after expression");
+    } else {
+        if (trace_) {
+            std::cerr << "Unexpected token type: "
+                      << static_cast<int>(peek().type) << std::endl;
+        }
+        throw std::runtime_error("Unexpected token in expression");
+    }
+
+    return expr;
+}
+
 Token Parser::consume(TokenType type, const std::string& error_message) {
     try {
-        std::cout << "Consuming token. Expected: " << static_cast<int>(type) 
-                  << ", Current: " << static_cast<int>(peek().type) << std::endl;
-        
+        if (trace_) {
+            std::cout << "Consuming token. Expected: " << static_cast<int>(type)
+                      << ", Current: " << static_cast<int>(peek().type) << std::endl;
+        }
+
         if (is_at_end()) {
             throw std::runtime_error("Unexpected end of token stream");
         }
@@ -154,26 +270,26 @@ Token Parser::consume(TokenType type, const std::string& error_message) {
         if (peek().type == type) {
             return advance();
         }
-        
+
         std::stringstream ss;
-        ss << "Token mismatch. Expected: " << static_cast<int>(type) 
+        ss << error_message << ". Expected: " << static_cast<int>(type)
            << ", Got: " << static_cast<int>(peek().type);
         throw std::runtime_error(ss.str());
     } catch (const std::runtime_error& e) {
-        std::cerr << "Error consuming token: " << e.what() << std::endl;
+        if (trace_) std::cerr << "Error consuming token: " << e.what() << std::endl;
         throw;
     }
 }
 
 bool Parser::is_at_end() {
     // Ensure we're within bounds and check for EOF
-    return current_token_ >= tokens_.size() || 
-           (current_token_ < tokens_.size() && 
-            (peek().type == TokenType::EOF_ || 
+    return current_token_ >= tokens_.size() ||
+           (current_token_ < tokens_.size() &&
+            (peek().type == TokenType::EOF_ ||
              current_token_ == tokens_.size() - 1));
 }
 
-Token Parser::peek() {
+const Token& Parser::peek() {
     // Defensive peek to prevent out-of-bounds access
     if (current_token_ >= tokens_.size()) {
         // If we're past the end, return the last token
@@ -182,18 +298,33 @@ Token Parser::peek() {
     return tokens_[current_token_];
 }
 
-Token Parser::previous() {
+const Token& Parser::previous() {
     if (current_token_ == 0) {
         throw std::runtime_error("Cannot get previous token at start of stream");
     }
     return tokens_[current_token_ - 1];
 }
 
-Token Parser::advance() {
+const Token& Parser::advance() {
     if (!is_at_end()) current_token_++;
     return previous();
 }
 
+void Parser::reportError(const std::string& context, const std::string& message) {
+    had_error_ = true;
+    if (trace_) {
+        std::cerr << context << ": " << message << std::endl;
+    }
+
+    // Errors unwind through several parse functions; keep the innermost one
+    if (!errors_.empty() && error_token_ == current_token_) {
+        return;
+    }
+    error_token_ = current_token_;
+    Token at = peek();
+    errors_.push_back({message, at.line, at.column});
+}
+
 void Parser::synchronize() {
     advance();
 
@@ -229,6 +360,10 @@ std::string VariableDeclaration::toString() const {
 std::string Expression::toString() const {
     if (type == Type::STRING_LITERAL) {
         return "String Literal: " + value;
+    } else if (type == Type::BINARY) {
+        return "Binary Expression: " + value;
+    } else if (type == Type::CALL) {
+        return "Call Expression: " + value;
     } else {
         return "Expression: " + value;
     }
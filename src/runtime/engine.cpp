@@ -0,0 +1,84 @@
+#include "../../include/runtime/engine.h"
+#include "../../include/lexer.hpp"
+#include "../../include/semantic/type_inference.h"
+#include <stdexcept>
+
+namespace novasyntax {
+
+const FunctionDeclaration* Script::function(const std::string& name) const {
+    auto it = globals_.find(name);
+    if (it == globals_.end()) return nullptr;
+    auto* func = std::get_if<const FunctionDeclaration*>(&it->second);
+    return func ? *func : nullptr;
+}
+
+const Value* Script::global(const std::string& name) const {
+    auto it = globals_.find(name);
+    return it == globals_.end() ? nullptr : &it->second;
+}
+
+Value Context::call(const Script& script, const FunctionDeclaration& func, const Value* arguments, size_t count) {
+    return callFunction(func, arguments, count, script.globals_, stack_);
+}
+
+Value Context::call(const Script& script, const std::string& name, std::initializer_list<Value> arguments) {
+    const FunctionDeclaration* func = script.function(name);
+    if (!func) {
+        throw std::runtime_error(script.name() + ": no function '" + name + "'");
+    }
+    return call(script, *func, arguments.begin(), arguments.size());
+}
+
+std::shared_ptr<const Script> Engine::compile(const std::string& source, const std::string& name) const {
+    // Not make_shared: the constructor is private to Engine
+    std::shared_ptr<Script> script(new Script());
+    script->name_ = name;
+
+    std::string diagnostics;
+    auto report = [&](int line, int column, const std::string& message) {
+        diagnostics += name;
+        diagnostics += ':';
+        diagnostics += std::to_string(line);
+        diagnostics += ':';
+        diagnostics += std::to_string(column);
+        diagnostics += ": ";
+        diagnostics += message;
+        diagnostics += '\n';
+    };
+
+    std::vector<Token> tokens;
+    try {
+        Lexer lexer(source);
+        tokens = lexer.tokenize();
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(name + ": " + e.what());
+    }
+
+    Parser parser(tokens, false);
+    script->program_ = parser.parseProgram();
+    for (const auto& error : parser.errors()) {
+        report(error.line, error.column, error.message);
+    }
+
+    if (diagnostics.empty() && options_.check_types) {
+        TypeInference inference;
+        for (const auto& error : inference.run(script->program_)) {
+            report(error.line, error.column, error.message);
+        }
+    }
+    if (!diagnostics.empty()) {
+        diagnostics.pop_back();
+        throw std::runtime_error(diagnostics);
+    }
+
+    // The stack used for top-level code is only needed here
+    CallStack stack;
+    try {
+        script->globals_ = evaluateGlobals(script->program_, stack);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(name + ":" + e.what());
+    }
+    return script;
+}
+
+} // namespace novasyntax
@@ -0,0 +1,237 @@
+#include "../../include/runtime/interpreter.h"
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+namespace novasyntax {
+
+namespace {
+
+[[noreturn]] void runtimeError(const ASTNode& at, const std::string& message) {
+    throw std::runtime_error(std::to_string(at.line) + ":" + std::to_string(at.column) + ": " + message);
+}
+
+const char* describeValue(const Value& value) {
+    switch (value.index()) {
+        case 1: return "number";
+        case 2: return "string";
+        case 3: return "function";
+        default: return "no value";
+    }
+}
+
+} // namespace
+
+// Evaluates nodes against a global scope and a call stack. Top-level
+// 'let's are only allowed while `defining` globals.
+class Evaluator {
+public:
+    Evaluator(const GlobalScope& globals, CallStack& stack, GlobalScope* defining = nullptr)
+        : globals_(globals), stack_(stack), defining_(defining) {}
+
+    // Runs `func` on arguments already pushed (unnamed) on top of the stack
+    Value invoke(const FunctionDeclaration& func, size_t arguments_begin);
+
+    Value execute(const ASTNode& node);
+
+private:
+    const GlobalScope& globals_;
+    CallStack& stack_;
+    GlobalScope* defining_;
+
+    Value evaluate(const Expression& expr);
+    const Value& lookup(const std::string& name, const ASTNode& at) const;
+};
+
+double numberLiteralValue(const std::string& text) {
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'b' || text[1] == 'B')) {
+        return static_cast<double>(std::strtoull(text.c_str() + 2, nullptr, 2));
+    }
+    // strtod handles both decimal and 0x hexadecimal
+    return std::strtod(text.c_str(), nullptr);
+}
+
+std::string valueToString(const Value& value) {
+    if (auto* number = std::get_if<double>(&value)) {
+        std::ostringstream ss;
+        ss.precision(15);
+        ss << *number;
+        return ss.str();
+    }
+    if (auto* text = std::get_if<std::string>(&value)) return *text;
+    if (auto* func = std::get_if<const FunctionDeclaration*>(&value)) return "<func " + (*func)->name + ">";
+    return "<no value>";
+}
+
+GlobalScope evaluateGlobals(const std::vector<std::unique_ptr<ASTNode>>& program, CallStack& stack) {
+    GlobalScope globals;
+    for (const auto& node : program) {
+        if (node && node->kind == NodeKind::FUNCTION) {
+            auto& func = static_cast<const FunctionDeclaration&>(*node);
+            globals[func.name] = &func;
+        }
+    }
+
+    Evaluator evaluator(globals, stack, &globals);
+    for (const auto& node : program) {
+        if (node && node->kind != NodeKind::FUNCTION) {
+            evaluator.execute(*node);
+        }
+    }
+    return globals;
+}
+
+Value callFunction(const FunctionDeclaration& func, const Value* arguments, size_t count,
+                   const GlobalScope& globals, CallStack& stack) {
+    size_t begin = stack.locals_.size();
+    for (size_t i = 0; i < count; ++i) {
+        stack.locals_.push_back({nullptr, arguments[i]});
+    }
+    return Evaluator(globals, stack).invoke(func, begin);
+}
+
+Value Evaluator::invoke(const FunctionDeclaration& func, size_t arguments_begin) {
+    // Unwind the frame on errors too, so the stack stays usable
+    struct FrameGuard {
+        CallStack& stack;
+        size_t saved_base;
+        size_t arguments_begin;
+        bool entered = false;
+        ~FrameGuard() {
+            stack.locals_.resize(arguments_begin);
+            if (entered) {
+                stack.frame_base_ = saved_base;
+                stack.depth_--;
+            }
+        }
+    } guard{stack_, stack_.frame_base_, arguments_begin};
+
+    size_t count = stack_.locals_.size() - arguments_begin;
+    if (count != func.parameters.size()) {
+        runtimeError(func, "'" + func.name + "' expects " + std::to_string(func.parameters.size()) +
+                           " arguments, got " + std::to_string(count));
+    }
+    if (stack_.depth_ >= kMaxCallDepth) {
+        runtimeError(func, "Maximum call depth exceeded in '" + func.name + "'");
+    }
+
+    stack_.frame_base_ = arguments_begin;
+    stack_.depth_++;
+    guard.entered = true;
+    for (size_t i = 0; i < count; ++i) {
+        stack_.locals_[arguments_begin + i].name = &func.parameters[i];
+    }
+
+    for (const auto& statement : func.statements) {
+        if (statement) execute(*statement);
+    }
+    return func.body ? execute(*func.body) : Value{};
+}
+
+Value Evaluator::execute(const ASTNode& node) {
+    switch (node.kind) {
+        case NodeKind::EXPRESSION:
+            return evaluate(static_cast<const Expression&>(node));
+        case NodeKind::VARIABLE: {
+            auto& var = static_cast<const VariableDeclaration&>(node);
+            Value value = var.initializer ? execute(*var.initializer) : Value{};
+            if (stack_.depth_ > 0) {
+                stack_.locals_.push_back({&var.name, std::move(value)});
+            } else if (defining_) {
+                (*defining_)[var.name] = std::move(value);
+            } else {
+                runtimeError(node, "Global '" + var.name + "' cannot be defined here");
+            }
+            return Value{};
+        }
+        case NodeKind::FUNCTION:
+            runtimeError(node, "Nested function declarations are not supported");
+    }
+    return Value{};
+}
+
+const Value& Evaluator::lookup(const std::string& name, const ASTNode& at) const {
+    const auto& locals = stack_.locals_;
+    for (size_t i = locals.size(); i > stack_.frame_base_; --i) {
+        const auto& local = locals[i - 1];
+        if (local.name && *local.name == name) return local.value;
+    }
+    auto it = globals_.find(name);
+    if (it == globals_.end()) {
+        runtimeError(at, "Undefined name '" + name + "'");
+    }
+    return it->second;
+}
+
+Value Evaluator::evaluate(const Expression& expr) {
+    switch (expr.type) {
+        case Expression::Type::LITERAL:
+            return numberLiteralValue(expr.value);
+
+        case Expression::Type::STRING_LITERAL:
+            return expr.value;
+
+        case Expression::Type::IDENTIFIER:
+            return lookup(expr.value, expr);
+
+        case Expression::Type::BINARY: {
+            Value left = evaluate(*expr.left);
+            Value right = evaluate(*expr.right);
+            auto* l = std::get_if<double>(&left);
+            auto* r = std::get_if<double>(&right);
+            if (l && r) {
+                switch (expr.op) {
+                    case TokenType::PLUS: return *l + *r;
+                    case TokenType::MINUS: return *l - *r;
+                    case TokenType::MULTIPLY: return *l * *r;
+                    default: return *l / *r;
+                }
+            }
+            if (expr.op == TokenType::PLUS && left.index() == 2 && right.index() == 2) {
+                return std::get<std::string>(left) + std::get<std::string>(right);
+            }
+            runtimeError(expr, "Operator '" + expr.value + "' cannot be applied to " +
+                               describeValue(left) + " and " + describeValue(right));
+        }
+
+        case Expression::Type::CALL: {
+            auto* func = std::get_if<const FunctionDeclaration*>(&lookup(expr.value, expr));
+            if (!func) {
+                runtimeError(expr, "'" + expr.value + "' is not a function");
+            }
+            const FunctionDeclaration& target = **func;
+
+            // Arguments go straight onto the stack, unnamed until the call
+            // starts, so they are not visible to each other
+            size_t begin = stack_.locals_.size();
+            for (const auto& argument : expr.arguments) {
+                Value value = evaluate(*argument);
+                stack_.locals_.push_back({nullptr, std::move(value)});
+            }
+            return invoke(target, begin);
+        }
+    }
+    return Value{};
+}
+
+Interpreter::Interpreter(const std::vector<std::unique_ptr<ASTNode>>& program)
+    : globals_(evaluateGlobals(program, stack_)) {}
+
+Value Interpreter::call(const std::string& name, const std::vector<Value>& arguments) {
+    auto it = globals_.find(name);
+    if (it == globals_.end()) {
+        throw std::runtime_error("Undefined function '" + name + "'");
+    }
+    auto* func = std::get_if<const FunctionDeclaration*>(&it->second);
+    if (!func) {
+        throw std::runtime_error("'" + name + "' is not a function");
+    }
+    return callFunction(**func, arguments.data(), arguments.size(), globals_, stack_);
+}
+
+const Value* Interpreter::global(const std::string& name) const {
+    auto it = globals_.find(name);
+    return it == globals_.end() ? nullptr : &it->second;
+}
+
+} // namespace novasyntax
@@ -0,0 +1,367 @@
+#include "../../include/semantic/type_inference.h"
+#include <utility>
+
+namespace novasyntax {
+
+const char* valueTypeName(ValueType type) {
+    switch (type) {
+        case ValueType::NUMBER: return "number";
+        case ValueType::STRING: return "string";
+        case ValueType::FUNCTION: return "function";
+        default: return "unknown";
+    }
+}
+
+std::vector<TypeDiagnostic> TypeInference::run(const std::vector<std::unique_ptr<ASTNode>>& program) {
+    terms_.clear();
+    args_.clear();
+    annotations_.clear();
+    plus_checks_.clear();
+    diagnostics_.clear();
+    globals_.clear();
+    locals_.clear();
+
+    // First pass: bind every top-level name so functions may refer to
+    // declarations that appear later in the file
+    std::vector<int> top_level(program.size(), -1);
+    for (size_t i = 0; i < program.size(); ++i) {
+        ASTNode* node = program[i].get();
+        std::string name;
+        int var = -1;
+
+        if (!node) {
+            continue;
+        } else if (node->kind == NodeKind::FUNCTION) {
+            auto* func = static_cast<FunctionDeclaration*>(node);
+            name = func->name;
+            var = freshFunction(static_cast<int>(func->parameters.size()));
+        } else if (node->kind == NodeKind::VARIABLE) {
+            name = static_cast<VariableDeclaration*>(node)->name;
+            var = fresh();
+        } else {
+            continue;
+        }
+
+        if (!globals_.emplace(name, var).second) {
+            error(*node, "Redefinition of '" + name + "'");
+            continue;
+        }
+        top_level[i] = var;
+    }
+
+    // Second pass: generate and solve constraints
+    for (size_t i = 0; i < program.size(); ++i) {
+        ASTNode* node = program[i].get();
+        if (!node) continue;
+        if (node->kind == NodeKind::FUNCTION) {
+            auto* func = static_cast<FunctionDeclaration*>(node);
+            if (top_level[i] >= 0) {
+                annotations_.emplace_back(func, top_level[i]);
+                inferFunction(*func);
+            }
+        } else if (node->kind == NodeKind::VARIABLE) {
+            auto* decl = static_cast<VariableDeclaration*>(node);
+            int value = inferNode(decl->initializer.get());
+            if (top_level[i] >= 0 && !unify(top_level[i], value)) {
+                error(*decl, "Conflicting types for '" + decl->name + "'");
+            }
+            if (top_level[i] >= 0) {
+                annotations_.emplace_back(decl, top_level[i]);
+            }
+        } else {
+            inferNode(node);
+        }
+    }
+
+    // '+' is only defined on numbers and strings; operands still unresolved
+    // here are left generic for the evaluator to dispatch at run time
+    for (const auto& [expr, var] : plus_checks_) {
+        if (terms_[find(var)].kind == ValueType::FUNCTION) {
+            error(*expr, "Operator '+' cannot be applied to functions");
+        }
+    }
+
+    // Write the solution back to the tree
+    for (const auto& [node, var] : annotations_) {
+        node->inferred_type = terms_[find(var)].kind;
+    }
+    for (const auto& node : program) {
+        if (!node || node->kind != NodeKind::FUNCTION) continue;
+        auto* func = static_cast<FunctionDeclaration*>(node.get());
+        auto it = globals_.find(func->name);
+        if (it == globals_.end()) continue;
+        const Term& term = terms_[find(it->second)];
+        if (term.kind != ValueType::FUNCTION ||
+            term.arity != static_cast<int>(func->parameters.size())) {
+            continue;
+        }
+        func->parameter_types.clear();
+        for (int p = 0; p < term.arity; ++p) {
+            func->parameter_types.push_back(terms_[find(args_[term.args_begin + p])].kind);
+        }
+        func->return_type = terms_[find(args_[term.args_begin + term.arity])].kind;
+    }
+
+    return std::move(diagnostics_);
+}
+
+void TypeInference::inferFunction(FunctionDeclaration& func) {
+    const Term& signature = terms_[find(globals_[func.name])];
+    int args_begin = signature.args_begin;
+    int arity = signature.arity;
+
+    locals_.clear();
+    in_function_ = true;
+    for (int p = 0; p < arity; ++p) {
+        locals_[func.parameters[p]] = args_[args_begin + p];
+    }
+
+    for (const auto& statement : func.statements) {
+        if (statement && statement->kind == NodeKind::VARIABLE) {
+            inferVariable(static_cast<VariableDeclaration&>(*statement), locals_);
+        } else {
+            inferNode(statement.get());
+        }
+    }
+
+    if (func.body) {
+        int result = inferNode(func.body.get());
+        if (!unify(args_[args_begin + arity], result)) {
+            error(*func.body, "Function '" + func.name + "' returns " + describe(result) +
+                              " but is used as returning " + describe(args_[args_begin + arity]));
+        }
+    }
+
+    in_function_ = false;
+    locals_.clear();
+}
+
+void TypeInference::inferVariable(VariableDeclaration& var, std::unordered_map<std::string, int>& scope) {
+    int value = inferNode(var.initializer.get());
+    scope[var.name] = value;
+    annotations_.emplace_back(&var, value);
+}
+
+int TypeInference::inferNode(ASTNode* node) {
+    if (!node) {
+        return fresh();
+    }
+    switch (node->kind) {
+        case NodeKind::EXPRESSION:
+            return inferExpression(static_cast<Expression&>(*node));
+        case NodeKind::VARIABLE:
+            inferVariable(static_cast<VariableDeclaration&>(*node), in_function_ ? locals_ : globals_);
+            break;
+        case NodeKind::FUNCTION:
+            error(*node, "Nested function declarations are not supported");
+            break;
+    }
+    return fresh();
+}
+
+int TypeInference::inferExpression(Expression& expr) {
+    int var = -1;
+
+    switch (expr.type) {
+        case Expression::Type::LITERAL:
+            var = fresh(ValueType::NUMBER);
+            break;
+
+        case Expression::Type::STRING_LITERAL:
+            var = fresh(ValueType::STRING);
+            break;
+
+        case Expression::Type::IDENTIFIER:
+            var = lookup(expr.value);
+            if (var < 0) {
+                error(expr, "Undefined name '" + expr.value + "'");
+                var = fresh();
+            }
+            break;
+
+        case Expression::Type::BINARY: {
+            int left = expr.left ? inferExpression(*expr.left) : fresh();
+            int right = expr.right ? inferExpression(*expr.right) : fresh();
+
+            if (expr.op == TokenType::PLUS) {
+                if (!unify(left, right)) {
+                    error(expr, "Type mismatch in '+': " + describe(left) + " and " + describe(right));
+                }
+                var = left;
+                plus_checks_.emplace_back(&expr, var);
+            } else {
+                var = fresh(ValueType::NUMBER);
+                if (!unify(left, var)) {
+                    error(expr, "Left operand of '" + expr.value + "' must be a number, got " + describe(left));
+                }
+                if (!unify(right, var)) {
+                    error(expr, "Right operand of '" + expr.value + "' must be a number, got " + describe(right));
+                }
+            }
+            break;
+        }
+
+        case Expression::Type::CALL: {
+            std::vector<int> arguments;
+            arguments.reserve(expr.arguments.size());
+            for (const auto& argument : expr.arguments) {
+                arguments.push_back(argument ? inferExpression(*argument) : fresh());
+            }
+
+            int callee = lookup(expr.value);
+            if (callee < 0) {
+                error(expr, "Undefined function '" + expr.value + "'");
+                var = fresh();
+                break;
+            }
+
+            int arity = static_cast<int>(arguments.size());
+            if (terms_[find(callee)].kind == ValueType::UNKNOWN) {
+                // Calling a value of unknown type constrains it to be a function
+                unify(callee, freshFunction(arity));
+            }
+
+            const Term& target = terms_[find(callee)];
+            if (target.kind != ValueType::FUNCTION) {
+                error(expr, "'" + expr.value + "' is a " + describe(callee) + ", not a function");
+                var = fresh();
+                break;
+            }
+            if (target.arity != arity) {
+                error(expr, "'" + expr.value + "' expects " + std::to_string(target.arity) +
+                            " argument(s), got " + std::to_string(arity));
+                var = fresh();
+                break;
+            }
+
+            int args_begin = target.args_begin;
+            for (int i = 0; i < arity; ++i) {
+                int parameter = args_[args_begin + i];
+                if (!unify(parameter, arguments[i])) {
+                    const ASTNode& at = expr.arguments[i] ? *expr.arguments[i] : static_cast<const ASTNode&>(expr);
+                    error(at, "Argument " + std::to_string(i + 1) + " of '" + expr.value + "' expects " +
+                              describe(parameter) + ", got " + describe(arguments[i]));
+                }
+            }
+            var = args_[args_begin + arity];
+            break;
+        }
+    }
+
+    annotations_.emplace_back(&expr, var);
+    return var;
+}
+
+int TypeInference::lookup(const std::string& name) {
+    if (in_function_) {
+        auto local = locals_.find(name);
+        if (local != locals_.end()) {
+            return local->second;
+        }
+    }
+    auto global = globals_.find(name);
+    return global != globals_.end() ? global->second : -1;
+}
+
+int TypeInference::fresh(ValueType kind) {
+    int id = static_cast<int>(terms_.size());
+    terms_.push_back({id, 0, kind, 0, 0});
+    return id;
+}
+
+int TypeInference::freshFunction(int arity) {
+    int args_begin = static_cast<int>(args_.size());
+    // Reserve the argument slots before creating their variables so the
+    // function's parameters stay contiguous in args_
+    args_.resize(args_.size() + arity + 1);
+    for (int i = 0; i <= arity; ++i) {
+        args_[args_begin + i] = fresh();
+    }
+
+    int id = fresh(ValueType::FUNCTION);
+    terms_[id].args_begin = args_begin;
+    terms_[id].arity = arity;
+    return id;
+}
+
+int TypeInference::find(int var) {
+    int root = var;
+    while (terms_[root].parent != root) {
+        root = terms_[root].parent;
+    }
+    // Path compression
+    while (terms_[var].parent != root) {
+        int next = terms_[var].parent;
+        terms_[var].parent = root;
+        var = next;
+    }
+    return root;
+}
+
+bool TypeInference::unify(int a, int b) {
+    // Scratch stack kept across calls, so unify does not allocate
+    unify_stack_.clear();
+    unify_stack_.emplace_back(a, b);
+    bool ok = true;
+
+    while (!unify_stack_.empty()) {
+        auto [x, y] = unify_stack_.back();
+        unify_stack_.pop_back();
+
+        x = find(x);
+        y = find(y);
+        if (x == y) continue;
+
+        Term& tx = terms_[x];
+        Term& ty = terms_[y];
+
+        if (tx.kind != ValueType::UNKNOWN && ty.kind != ValueType::UNKNOWN) {
+            if (tx.kind != ty.kind ||
+                (tx.kind == ValueType::FUNCTION && tx.arity != ty.arity)) {
+                ok = false;
+                continue;
+            }
+        }
+
+        // Union by rank; the surviving root keeps whichever structure is known
+        if (tx.rank < ty.rank) std::swap(x, y);
+        Term& root = terms_[x];
+        Term& child = terms_[y];
+        if (root.rank == child.rank) root.rank++;
+        child.parent = x;
+
+        if (root.kind == ValueType::UNKNOWN) {
+            root.kind = child.kind;
+            root.args_begin = child.args_begin;
+            root.arity = child.arity;
+        } else if (root.kind == ValueType::FUNCTION && child.kind == ValueType::FUNCTION) {
+            for (int i = 0; i <= root.arity; ++i) {
+                unify_stack_.emplace_back(args_[root.args_begin + i], args_[child.args_begin + i]);
+            }
+        }
+    }
+
+    return ok;
+}
+
+std::string TypeInference::describe(int var) {
+    const Term& term = terms_[find(var)];
+    if (term.kind != ValueType::FUNCTION) {
+        return valueTypeName(term.kind);
+    }
+
+    std::string text = "function(";
+    for (int i = 0; i < term.arity; ++i) {
+        if (i > 0) text += ", ";
+        text += valueTypeName(terms_[find(args_[term.args_begin + i])].kind);
+    }
+    text += ") -> ";
+    text += valueTypeName(terms_[find(args_[term.args_begin + term.arity])].kind);
+    return text;
+}
+
+void TypeInference::error(const ASTNode& node, std::string message) {
+    diagnostics_.push_back({std::move(message), node.line, node.column});
+}
+
+} // namespace novasyntax
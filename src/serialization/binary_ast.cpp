@@ -0,0 +1,315 @@
+#include "../../include/serialization/binary_ast.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace novasyntax {
+
+namespace {
+
+constexpr char kMagic[4] = {'N', 'S', 'A', 'B'};
+
+class Serializer {
+public:
+    std::vector<BinaryAstNode> nodes;
+    std::vector<uint32_t> children;
+    std::vector<uint32_t> string_offsets{0};
+    std::string string_data;
+
+    // Child indices of the nodes currently being emitted; each node copies
+    // its own slice into `children` once all of its subtrees are written
+    std::vector<uint32_t> pending;
+
+    uint32_t intern(const std::string& text) {
+        auto it = interned_.find(text);
+        if (it != interned_.end()) return it->second;
+
+        uint32_t index = static_cast<uint32_t>(string_offsets.size() - 1);
+        string_data += text;
+        string_offsets.push_back(static_cast<uint32_t>(string_data.size()));
+        interned_.emplace(text, index);
+        return index;
+    }
+
+    uint32_t add(BinaryAstKind kind, const std::string& value, const ASTNode& source) {
+        BinaryAstNode record{};
+        record.kind = static_cast<uint8_t>(kind);
+        record.value_type = static_cast<uint8_t>(source.inferred_type);
+        record.value = intern(value);
+        record.line = static_cast<uint32_t>(source.line);
+        record.column = static_cast<uint32_t>(source.column);
+        nodes.push_back(record);
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+
+    void closeChildren(uint32_t index, size_t mark) {
+        nodes[index].first_child = static_cast<uint32_t>(children.size());
+        nodes[index].child_count = static_cast<uint32_t>(pending.size() - mark);
+        children.insert(children.end(), pending.begin() + static_cast<std::ptrdiff_t>(mark), pending.end());
+        pending.resize(mark);
+    }
+
+    // Returns false for null nodes, which are skipped
+    bool emit(const ASTNode* node) {
+        if (!node) return false;
+
+        switch (node->kind) {
+            case NodeKind::EXPRESSION:
+                emitExpression(static_cast<const Expression&>(*node));
+                break;
+            case NodeKind::VARIABLE:
+                emitVariable(static_cast<const VariableDeclaration&>(*node));
+                break;
+            case NodeKind::FUNCTION:
+                emitFunction(static_cast<const FunctionDeclaration&>(*node));
+                break;
+        }
+        return true;
+    }
+
+private:
+    std::unordered_map<std::string, uint32_t> interned_;
+
+    void emitVariable(const VariableDeclaration& var) {
+        uint32_t index = add(BinaryAstKind::VARIABLE, var.name, var);
+        size_t mark = pending.size();
+        emit(var.initializer.get());
+        closeChildren(index, mark);
+        pending.push_back(index);
+    }
+
+    void emitFunction(const FunctionDeclaration& func) {
+        uint32_t index = add(BinaryAstKind::FUNCTION, func.name, func);
+        size_t mark = pending.size();
+        for (size_t i = 0; i < func.parameters.size(); ++i) {
+            uint32_t param = add(BinaryAstKind::PARAMETER, func.parameters[i], func);
+            ValueType type = i < func.parameter_types.size() ? func.parameter_types[i] : ValueType::UNKNOWN;
+            nodes[param].value_type = static_cast<uint8_t>(type);
+            pending.push_back(param);
+        }
+        for (const auto& statement : func.statements) {
+            emit(statement.get());
+        }
+        if (emit(func.body.get())) {
+            nodes[index].flags |= kBinaryAstHasBody;
+        }
+        nodes[index].extra = static_cast<uint32_t>(func.parameters.size());
+        closeChildren(index, mark);
+        pending.push_back(index);
+    }
+
+    void emitExpression(const Expression& expr) {
+        BinaryAstKind kind = BinaryAstKind::NUMBER;
+        switch (expr.type) {
+            case Expression::Type::LITERAL: kind = BinaryAstKind::NUMBER; break;
+            case Expression::Type::STRING_LITERAL: kind = BinaryAstKind::STRING; break;
+            case Expression::Type::IDENTIFIER: kind = BinaryAstKind::IDENTIFIER; break;
+            case Expression::Type::BINARY: kind = BinaryAstKind::BINARY; break;
+            case Expression::Type::CALL: kind = BinaryAstKind::CALL; break;
+        }
+
+        uint32_t index = add(kind, expr.value, expr);
+        nodes[index].op = static_cast<uint8_t>(expr.op);
+
+        size_t mark = pending.size();
+        if (kind == BinaryAstKind::BINARY) {
+            emit(expr.left.get());
+            emit(expr.right.get());
+        } else if (kind == BinaryAstKind::CALL) {
+            for (const auto& argument : expr.arguments) {
+                emit(argument.get());
+            }
+        }
+        closeChildren(index, mark);
+        pending.push_back(index);
+    }
+};
+
+template <typename T>
+char* copyBytes(char* out, const T* data, size_t count) {
+    if (count == 0) return out;
+    std::memcpy(out, data, count * sizeof(T));
+    return out + count * sizeof(T);
+}
+
+} // namespace
+
+std::vector<char> BinaryAstWriter::serialize(const std::vector<std::unique_ptr<ASTNode>>& program) {
+    Serializer serializer;
+    for (const auto& node : program) {
+        serializer.emit(node.get());
+    }
+
+    // The remaining pending indices are the top-level nodes
+    uint32_t root_begin = static_cast<uint32_t>(serializer.children.size());
+    uint32_t root_count = static_cast<uint32_t>(serializer.pending.size());
+    serializer.children.insert(serializer.children.end(), serializer.pending.begin(), serializer.pending.end());
+
+    BinaryAstHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kBinaryAstVersion;
+    header.node_count = static_cast<uint32_t>(serializer.nodes.size());
+    header.child_count = static_cast<uint32_t>(serializer.children.size());
+    header.root_begin = root_begin;
+    header.root_count = root_count;
+    header.string_count = static_cast<uint32_t>(serializer.string_offsets.size() - 1);
+    header.string_bytes = static_cast<uint32_t>(serializer.string_data.size());
+
+    std::vector<char> out(sizeof(header) + serializer.nodes.size() * sizeof(BinaryAstNode) +
+                          (serializer.children.size() + serializer.string_offsets.size()) * sizeof(uint32_t) +
+                          serializer.string_data.size());
+    char* cursor = out.data();
+    cursor = copyBytes(cursor, &header, 1);
+    cursor = copyBytes(cursor, serializer.nodes.data(), serializer.nodes.size());
+    cursor = copyBytes(cursor, serializer.children.data(), serializer.children.size());
+    cursor = copyBytes(cursor, serializer.string_offsets.data(), serializer.string_offsets.size());
+    copyBytes(cursor, serializer.string_data.data(), serializer.string_data.size());
+    return out;
+}
+
+void BinaryAstWriter::writeFile(const std::string& path, const std::vector<std::unique_ptr<ASTNode>>& program) {
+    std::vector<char> bytes = serialize(program);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        throw std::runtime_error("Cannot write binary AST to " + path);
+    }
+}
+
+BinaryAstView::BinaryAstView(const void* data, size_t size) {
+    if (size < sizeof(BinaryAstHeader)) {
+        throw std::runtime_error("Binary AST is truncated");
+    }
+    if (reinterpret_cast<uintptr_t>(data) % alignof(uint32_t) != 0) {
+        throw std::runtime_error("Binary AST buffer is not 4-byte aligned");
+    }
+
+    const char* base = static_cast<const char*>(data);
+    header_ = reinterpret_cast<const BinaryAstHeader*>(base);
+    if (std::memcmp(header_->magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a binary AST (bad magic)");
+    }
+    if (header_->version != kBinaryAstVersion) {
+        throw std::runtime_error("Unsupported binary AST version " + std::to_string(header_->version));
+    }
+
+    // Section bounds, in 64-bit arithmetic so corrupt counts cannot wrap
+    uint64_t nodes_offset = sizeof(BinaryAstHeader);
+    uint64_t children_offset = nodes_offset + uint64_t{header_->node_count} * sizeof(BinaryAstNode);
+    uint64_t offsets_offset = children_offset + uint64_t{header_->child_count} * sizeof(uint32_t);
+    uint64_t strings_offset = offsets_offset + (uint64_t{header_->string_count} + 1) * sizeof(uint32_t);
+    if (strings_offset + header_->string_bytes > size) {
+        throw std::runtime_error("Binary AST is truncated");
+    }
+
+    nodes_ = reinterpret_cast<const BinaryAstNode*>(base + nodes_offset);
+    children_ = reinterpret_cast<const uint32_t*>(base + children_offset);
+    string_offsets_ = reinterpret_cast<const uint32_t*>(base + offsets_offset);
+    strings_ = base + strings_offset;
+
+    // One linear pass so accessors can skip bounds checks. Children always
+    // come after their parent in pre-order, which also rules out cycles.
+    if (uint64_t{header_->root_begin} + header_->root_count > header_->child_count) {
+        throw std::runtime_error("Binary AST root range is out of bounds");
+    }
+    for (uint32_t i = 0; i < header_->root_count; ++i) {
+        if (children_[header_->root_begin + i] >= header_->node_count) {
+            throw std::runtime_error("Binary AST root index is out of bounds");
+        }
+    }
+    if (string_offsets_[0] != 0 || string_offsets_[header_->string_count] != header_->string_bytes) {
+        throw std::runtime_error("Binary AST string table is corrupt");
+    }
+    for (uint32_t i = 0; i < header_->string_count; ++i) {
+        if (string_offsets_[i] > string_offsets_[i + 1]) {
+            throw std::runtime_error("Binary AST string table is corrupt");
+        }
+    }
+    for (uint32_t i = 0; i < header_->node_count; ++i) {
+        const BinaryAstNode& node = nodes_[i];
+        if (node.kind > static_cast<uint8_t>(BinaryAstKind::CALL) ||
+            node.value >= header_->string_count ||
+            uint64_t{node.first_child} + node.child_count > header_->child_count) {
+            throw std::runtime_error("Binary AST node " + std::to_string(i) + " is corrupt");
+        }
+        for (uint32_t c = 0; c < node.child_count; ++c) {
+            uint32_t child = children_[node.first_child + c];
+            if (child <= i || child >= header_->node_count) {
+                throw std::runtime_error("Binary AST node " + std::to_string(i) + " has an invalid child");
+            }
+        }
+        if (!hasValidShape(node)) {
+            throw std::runtime_error("Binary AST node " + std::to_string(i) + " has the wrong children for its kind");
+        }
+    }
+}
+
+bool BinaryAstView::hasValidShape(const BinaryAstNode& node) const {
+    switch (static_cast<BinaryAstKind>(node.kind)) {
+        case BinaryAstKind::FUNCTION: {
+            if (node.extra > node.child_count) return false;
+            bool has_body = (node.flags & kBinaryAstHasBody) != 0;
+            if (has_body && node.child_count == node.extra) return false;
+            for (uint32_t c = 0; c < node.extra; ++c) {
+                if (nodes_[children_[node.first_child + c]].kind != static_cast<uint8_t>(BinaryAstKind::PARAMETER)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case BinaryAstKind::VARIABLE:
+            return node.child_count <= 1;
+        case BinaryAstKind::BINARY:
+            return node.child_count == 2;
+        case BinaryAstKind::CALL:
+            return true;
+        case BinaryAstKind::PARAMETER:
+        case BinaryAstKind::NUMBER:
+        case BinaryAstKind::STRING:
+        case BinaryAstKind::IDENTIFIER:
+            return node.child_count == 0;
+    }
+    return false;
+}
+
+MappedBinaryAst::MappedBinaryAst(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open binary AST " + path);
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BinaryAstHeader))) {
+        ::close(fd);
+        throw std::runtime_error("Binary AST " + path + " is truncated");
+    }
+
+    size_ = static_cast<size_t>(info.st_size);
+    data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Cannot map binary AST " + path);
+    }
+
+    try {
+        view_ = std::make_unique<BinaryAstView>(data_, size_);
+    } catch (...) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+        throw;
+    }
+}
+
+MappedBinaryAst::~MappedBinaryAst() {
+    if (data_) {
+        ::munmap(data_, size_);
+    }
+}
+
+} // namespace novasyntax
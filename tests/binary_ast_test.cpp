@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include "semantic/type_inference.h"
+#include "serialization/binary_ast.h"
+#include "test_support.h"
+#include <cstring>
+
+namespace {
+
+using novasyntax::BinaryAstKind;
+using novasyntax::BinaryAstNodeRef;
+using novasyntax::test::parseSource;
+
+void expectSameExpression(const novasyntax::Expression& expr, BinaryAstNodeRef node) {
+    EXPECT_EQ(node.value(), expr.value);
+    EXPECT_EQ(node.line(), expr.line);
+    EXPECT_EQ(node.column(), expr.column);
+    EXPECT_EQ(node.valueType(), expr.inferred_type);
+
+    switch (expr.type) {
+        case novasyntax::Expression::Type::BINARY:
+            ASSERT_EQ(node.kind(), BinaryAstKind::BINARY);
+            EXPECT_EQ(node.op(), expr.op);
+            ASSERT_EQ(node.childCount(), 2u);
+            expectSameExpression(*expr.left, node.child(0));
+            expectSameExpression(*expr.right, node.child(1));
+            break;
+        case novasyntax::Expression::Type::CALL:
+            ASSERT_EQ(node.kind(), BinaryAstKind::CALL);
+            ASSERT_EQ(node.childCount(), expr.arguments.size());
+            for (uint32_t i = 0; i < node.childCount(); ++i) {
+                expectSameExpression(*expr.arguments[i], node.child(i));
+            }
+            break;
+        case novasyntax::Expression::Type::STRING_LITERAL:
+            EXPECT_EQ(node.kind(), BinaryAstKind::STRING);
+            break;
+        case novasyntax::Expression::Type::IDENTIFIER:
+            EXPECT_EQ(node.kind(), BinaryAstKind::IDENTIFIER);
+            break;
+        case novasyntax::Expression::Type::LITERAL:
+            EXPECT_EQ(node.kind(), BinaryAstKind::NUMBER);
+            break;
+    }
+}
+
+void expectSameNode(const novasyntax::ASTNode& ast, BinaryAstNodeRef node) {
+    if (auto* expr = dynamic_cast<const novasyntax::Expression*>(&ast)) {
+        expectSameExpression(*expr, node);
+    } else if (auto* var = dynamic_cast<const novasyntax::VariableDeclaration*>(&ast)) {
+        ASSERT_EQ(node.kind(), BinaryAstKind::VARIABLE);
+        EXPECT_EQ(node.value(), var->name);
+        EXPECT_EQ(node.valueType(), var->inferred_type);
+        ASSERT_EQ(node.childCount(), 1u);
+        expectSameNode(*var->initializer, node.child(0));
+    } else if (auto* func = dynamic_cast<const novasyntax::FunctionDeclaration*>(&ast)) {
+        ASSERT_EQ(node.kind(), BinaryAstKind::FUNCTION);
+        EXPECT_EQ(node.value(), func->name);
+        EXPECT_EQ(node.line(), func->line);
+        ASSERT_EQ(node.parameterCount(), func->parameters.size());
+        EXPECT_EQ(node.hasBody(), func->body != nullptr);
+        ASSERT_EQ(node.childCount(), func->parameters.size() + func->statements.size() + (func->body ? 1 : 0));
+
+        uint32_t child = 0;
+        for (size_t i = 0; i < func->parameters.size(); ++i, ++child) {
+            EXPECT_EQ(node.child(child).kind(), BinaryAstKind::PARAMETER);
+            EXPECT_EQ(node.child(child).value(), func->parameters[i]);
+            EXPECT_EQ(node.child(child).valueType(), func->parameter_types[i]);
+        }
+        for (const auto& statement : func->statements) {
+            expectSameNode(*statement, node.child(child++));
+        }
+        if (func->body) {
+            expectSameNode(*func->body, node.child(child));
+        }
+    } else {
+        FAIL() << "Unexpected AST node";
+    }
+}
+
+const char* kProgram = R"(
+    func scale(x, factor) {
+        let result = x * factor
+        log(result)
+        return result + 0xAF
+    }
+    func log(value) { value }
+    func nothing() {}
+    let label = "scaled"
+    let answer = scale(2, 21) - (1 - 2)
+)";
+
+} // namespace
+
+TEST(BinaryAstTest, RoundTripThroughMappedFile) {
+    auto program = parseSource(kProgram);
+    novasyntax::TypeInference inference;
+    ASSERT_TRUE(inference.run(program).empty());
+
+    std::string path = ::testing::TempDir() + "novasyntax_round_trip.nsast";
+    novasyntax::BinaryAstWriter().writeFile(path, program);
+
+    novasyntax::MappedBinaryAst mapped(path);
+    const auto& view = mapped.view();
+    ASSERT_EQ(view.rootCount(), program.size());
+    for (uint32_t i = 0; i < view.rootCount(); ++i) {
+        expectSameNode(*program[i], view.root(i));
+    }
+    std::remove(path.c_str());
+}
+
+TEST(BinaryAstTest, InternsRepeatedStrings) {
+    auto program = parseSource("let a = x + x + x + x");
+    auto bytes = novasyntax::BinaryAstWriter().serialize(program);
+
+    novasyntax::BinaryAstHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    // "a", "x" and "+"
+    EXPECT_EQ(header.string_count, 3u);
+    EXPECT_EQ(header.node_count, 8u);
+}
+
+TEST(BinaryAstTest, RejectsMalformedInput) {
+    auto program = parseSource(kProgram);
+    auto bytes = novasyntax::BinaryAstWriter().serialize(program);
+
+    EXPECT_NO_THROW(novasyntax::BinaryAstView(bytes.data(), bytes.size()));
+    EXPECT_THROW(novasyntax::BinaryAstView(bytes.data(), bytes.size() - 1), std::runtime_error);
+    EXPECT_THROW(novasyntax::BinaryAstView(bytes.data(), 8), std::runtime_error);
+
+    auto bad_magic = bytes;
+    bad_magic[0] = 'X';
+    EXPECT_THROW(novasyntax::BinaryAstView(bad_magic.data(), bad_magic.size()), std::runtime_error);
+
+    // Point the first child of the first node back at itself
+    auto cycle = bytes;
+    novasyntax::BinaryAstNode first;
+    std::memcpy(&first, cycle.data() + sizeof(novasyntax::BinaryAstHeader), sizeof(first));
+    ASSERT_GT(first.child_count, 0u);
+    novasyntax::BinaryAstHeader header;
+    std::memcpy(&header, cycle.data(), sizeof(header));
+    size_t children = sizeof(header) + header.node_count * sizeof(novasyntax::BinaryAstNode);
+    uint32_t self = 0;
+    std::memcpy(cycle.data() + children + first.first_child * sizeof(uint32_t), &self, sizeof(self));
+    EXPECT_THROW(novasyntax::BinaryAstView(cycle.data(), cycle.size()), std::runtime_error);
+
+    // Node shapes that pass the bounds and ordering checks but do not fit
+    // their kind. Each mutation keeps every child index valid.
+    auto nodeAt = [&](const std::vector<char>& buffer, uint32_t i) {
+        novasyntax::BinaryAstNode node;
+        std::memcpy(&node, buffer.data() + sizeof(header) + i * sizeof(node), sizeof(node));
+        return node;
+    };
+    auto findNode = [&](BinaryAstKind kind, uint32_t child_count) {
+        for (uint32_t i = 0; i < header.node_count; ++i) {
+            auto node = nodeAt(bytes, i);
+            if (node.kind == static_cast<uint8_t>(kind) && node.child_count == child_count) return i;
+        }
+        ADD_FAILURE() << "No node of the wanted shape";
+        return 0u;
+    };
+    auto expectRejected = [&](uint32_t i, auto mutate) {
+        auto corrupt = bytes;
+        auto node = nodeAt(corrupt, i);
+        mutate(node);
+        std::memcpy(corrupt.data() + sizeof(header) + i * sizeof(node), &node, sizeof(node));
+        try {
+            novasyntax::BinaryAstView(corrupt.data(), corrupt.size());
+            ADD_FAILURE() << "Accepted a bad shape for node " << i;
+        } catch (const std::runtime_error& e) {
+            EXPECT_NE(std::string(e.what()).find("wrong children"), std::string::npos) << e.what();
+        }
+    };
+
+    // scale(x, factor): node 0, parameters then three more children
+    ASSERT_EQ(first.kind, static_cast<uint8_t>(BinaryAstKind::FUNCTION));
+    ASSERT_EQ(first.extra, 2u);
+    expectRejected(0, [](auto& node) { node.extra = node.child_count + 1; });
+    expectRejected(0, [](auto& node) { node.extra = 3; });
+    expectRejected(findNode(BinaryAstKind::FUNCTION, 0), [](auto& node) { node.flags = novasyntax::kBinaryAstHasBody; });
+
+    // Give parameter x (node 1) one of scale's later children
+    expectRejected(1, [&](auto& node) {
+        node.first_child = first.first_child + 1;
+        node.child_count = 1;
+    });
+    expectRejected(findNode(BinaryAstKind::BINARY, 2), [](auto& node) { node.child_count = 1; });
+    // 'answer' is the last node with an initializer, whose children follow it
+    uint32_t answer = header.node_count - 1;
+    while (nodeAt(bytes, answer).kind != static_cast<uint8_t>(BinaryAstKind::VARIABLE)) --answer;
+    expectRejected(answer, [&](auto& node) {
+        auto binary = nodeAt(bytes, answer + 1);
+        node.first_child = binary.first_child;
+        node.child_count = 2;
+    });
+
+    EXPECT_THROW(novasyntax::MappedBinaryAst("/nonexistent/novasyntax.nsast"), std::runtime_error);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "codegen/c_backend.h"
+#include "runtime/interpreter.h"
+#include "semantic/type_inference.h"
+#include "test_support.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+std::vector<std::unique_ptr<novasyntax::ASTNode>> parseAndInfer(const std::string& source) {
+    auto program = novasyntax::test::parseSource(source);
+    novasyntax::TypeInference inference;
+    EXPECT_TRUE(inference.run(program).empty());
+    return program;
+}
+
+std::string skipReason(const novasyntax::CBackend& backend, const std::string& name) {
+    for (const auto& skipped : backend.skipped()) {
+        if (skipped.name == name) return skipped.reason;
+    }
+    return "";
+}
+
+const char* kNumeric = R"(
+    func poly(x) { return 3 * x * x - 2 * x + 0b101 }
+    func dist2(x1, y1, x2, y2) {
+        let dx = x2 - x1
+        let dy = y2 - y1
+        let dx = dx * dx
+        poly(dx)
+        return dx + dy * dy
+    }
+    func mix(a, b, c) { dist2(a, b, c, poly(a)) / 0x10 + 42.5e-2 }
+    func constant() { 7 }
+)";
+
+} // namespace
+
+TEST(CBackendTest, SelectsLowerableFunctions) {
+    auto program = parseAndInfer(R"(
+        func square(x) { x * x }
+        func greet(name) { "Hello, " + name }
+        func uses_global(x) { x + offset }
+        func calls_global(x) {
+            let y = square(x)
+            return uses_global(y) * 2
+        }
+        func prints(x) { greet("a") }
+        func spin(x) { spin(x) + 1 }
+        func spin_caller(x) { spin(x) }
+        let offset = 3
+    )");
+
+    novasyntax::CBackend backend;
+    const std::string& c = backend.emit(program, "test.nova");
+
+    ASSERT_EQ(backend.lowered().size(), 1u);
+    EXPECT_EQ(backend.lowered()[0].name, "square");
+    EXPECT_EQ(backend.lowered()[0].arity, 1u);
+    EXPECT_NE(c.find("double ns_square(double v0_x)"), std::string::npos);
+    EXPECT_NE(c.find("{\"square\", 1}"), std::string::npos);
+
+    EXPECT_EQ(skipReason(backend, "greet"), "does not return a number");
+    EXPECT_EQ(skipReason(backend, "uses_global"), "reads global 'offset'");
+    EXPECT_EQ(skipReason(backend, "calls_global"), "calls 'uses_global', which is not lowered");
+    EXPECT_EQ(skipReason(backend, "prints"), "does not return a number");
+    EXPECT_EQ(skipReason(backend, "spin"), "is recursive");
+    EXPECT_EQ(skipReason(backend, "spin_caller"), "calls 'spin', which is not lowered");
+}
+
+TEST(CBackendTest, RedeclaredLetsGetDistinctNames) {
+    auto program = parseAndInfer(kNumeric);
+    novasyntax::CBackend backend;
+    const std::string& c = backend.emit(program);
+
+    EXPECT_EQ(backend.lowered().size(), 4u);
+    EXPECT_TRUE(backend.skipped().empty());
+    // The second 'dx' reads the first one
+    EXPECT_NE(c.find("double v6_dx = (v4_dx * v4_dx);"), std::string::npos) << c;
+    EXPECT_NE(c.find("(void)ns_poly(v6_dx);"), std::string::npos) << c;
+    EXPECT_NE(c.find("double ns_constant(void)"), std::string::npos) << c;
+}
+
+TEST(CBackendTest, SourceNameCannotCloseHeaderComment) {
+    auto program = parseAndInfer("func f(x) { x }");
+    novasyntax::CBackend backend;
+    const std::string& c = backend.emit(program, "odd*/dir/f.nova");
+
+    const std::string header = "/* Generated by novasyntax build from odd* /dir/f.nova. Do not edit. */\n";
+    EXPECT_EQ(c.compare(0, header.size(), header), 0) << c;
+    EXPECT_EQ(c.find("*/"), header.size() - 3);
+}
+
+TEST(CBackendTest, NativeMatchesInterpreter) {
+    auto program = parseAndInfer(kNumeric);
+    novasyntax::CBackend backend;
+    std::string c_path = ::testing::TempDir() + "novasyntax_backend_test.c";
+    std::string so_path = ::testing::TempDir() + "novasyntax_backend_test.so";
+    {
+        std::ofstream file(c_path);
+        file << backend.emit(program);
+    }
+
+    std::string error;
+    if (!novasyntax::compileSharedObject(c_path, so_path, error)) {
+        if (std::system("${CC:-cc} --version > /dev/null 2>&1") != 0) {
+            GTEST_SKIP() << "No C compiler available";
+        }
+        FAIL() << error;
+    }
+
+    novasyntax::NativeModule module(so_path);
+    novasyntax::Interpreter interpreter(program);
+    ASSERT_EQ(module.functions().size(), 4u);
+
+    const double inputs[][4] = {{0, 0, 0, 0}, {1.5, -2, 3, 4.25}, {-7, 11, 0.5, 2}};
+    for (const auto& input : inputs) {
+        for (const auto& lowered : backend.lowered()) {
+            const novasyntax::NativeFunction* native = module.function(lowered.name);
+            ASSERT_NE(native, nullptr);
+            ASSERT_EQ(native->arity, lowered.arity);
+
+            std::vector<novasyntax::Value> arguments(input, input + lowered.arity);
+            double expected = std::get<double>(interpreter.call(lowered.name, arguments));
+            EXPECT_EQ(native->call(input), expected) << lowered.name;
+        }
+    }
+    EXPECT_EQ(module.function("missing"), nullptr);
+
+    std::remove(c_path.c_str());
+    std::remove(so_path.c_str());
+    EXPECT_THROW(novasyntax::NativeModule{so_path + ".missing"}, std::runtime_error);
+}
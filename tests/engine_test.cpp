@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "runtime/engine.h"
+#include <thread>
+
+namespace {
+
+const char* kScript = R"(
+    func area(w, h) { w * h }
+    func shape(w, h) {
+        let a = area(w, h)
+        return a + border
+    }
+    func label(name) { "shape: " + name }
+    let border = area(2, 3)
+)";
+
+} // namespace
+
+TEST(EngineTest, CompileOnceAndCall) {
+    novasyntax::Engine engine;
+    auto script = engine.compile(kScript, "shapes.nova");
+
+    EXPECT_EQ(script->name(), "shapes.nova");
+    EXPECT_DOUBLE_EQ(std::get<double>(*script->global("border")), 6);
+    EXPECT_EQ(script->function("border"), nullptr);
+    EXPECT_EQ(script->function("missing"), nullptr);
+
+    const novasyntax::FunctionDeclaration* shape = script->function("shape");
+    ASSERT_NE(shape, nullptr);
+
+    novasyntax::Context context;
+    EXPECT_DOUBLE_EQ(std::get<double>(context.call(*script, *shape, {3.0, 4.0})), 18);
+    EXPECT_DOUBLE_EQ(std::get<double>(context.call(*script, *shape, {1.0, 1.0})), 7);
+    EXPECT_EQ(std::get<std::string>(context.call(*script, "label", {std::string("box")})), "shape: box");
+    EXPECT_THROW(context.call(*script, "missing", {}), std::runtime_error);
+}
+
+TEST(EngineTest, CompileErrorsListEveryDiagnostic) {
+    novasyntax::Engine engine;
+    try {
+        engine.compile("let a = 1 + \"x\"\nlet b = c", "bad.nova");
+        FAIL() << "Expected a compile error";
+    } catch (const std::runtime_error& e) {
+        std::string message = e.what();
+        EXPECT_NE(message.find("bad.nova:1:"), std::string::npos) << message;
+        EXPECT_NE(message.find("bad.nova:2:"), std::string::npos) << message;
+    }
+
+    EXPECT_THROW(engine.compile("func f( {", "syntax.nova"), std::runtime_error);
+
+    // Without type checking the same script only fails when run
+    novasyntax::Engine unchecked({false});
+    auto script = unchecked.compile("func f(x) { x - \"one\" }");
+    novasyntax::Context context;
+    EXPECT_THROW(context.call(*script, "f", {1.0}), std::runtime_error);
+}
+
+TEST(EngineTest, ContextRecoversFromRuntimeErrors) {
+    novasyntax::Engine engine;
+    auto script = engine.compile("func loop(x) { loop(x) }\nfunc inc(x) { x + 1 }");
+
+    novasyntax::Context context;
+    EXPECT_THROW(context.call(*script, "loop", {1.0}), std::runtime_error);
+    EXPECT_THROW(context.call(*script, "inc", {1.0, 2.0}), std::runtime_error);
+    EXPECT_DOUBLE_EQ(std::get<double>(context.call(*script, "inc", {1.0})), 2);
+}
+
+TEST(EngineTest, ScriptIsSharedAcrossThreads) {
+    novasyntax::Engine engine;
+    std::shared_ptr<const novasyntax::Script> script = engine.compile(kScript);
+    const novasyntax::FunctionDeclaration* shape = script->function("shape");
+
+    constexpr int kThreads = 4;
+    constexpr int kCalls = 2000;
+    std::vector<double> sums(kThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            novasyntax::Context context;
+            for (int i = 0; i < kCalls; ++i) {
+                sums[t] += std::get<double>(context.call(*script, *shape, {double(t), double(i)}));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (int t = 0; t < kThreads; ++t) {
+        // sum over i of (t * i + 6)
+        double expected = t * (kCalls - 1) * kCalls / 2.0 + 6.0 * kCalls;
+        EXPECT_DOUBLE_EQ(sums[t], expected) << "thread " << t;
+    }
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "parser/ast_visitor.h"
+#include "parser/flat_ast.h"
+#include "test_support.h"
+#include <optional>
+#include <string>
+
+namespace {
+
+using novasyntax::FlatNode;
+using novasyntax::FlatNodeKind;
+using novasyntax::test::parseSource;
+
+struct KindCounter : novasyntax::AstVisitor<KindCounter> {
+    int expressions = 0;
+    int variables = 0;
+    int functions = 0;
+
+    void visitExpression(const novasyntax::Expression& expr) {
+        expressions++;
+        visitChildren(expr);
+    }
+    void visitVariable(const novasyntax::VariableDeclaration& var) {
+        variables++;
+        visitChildren(var);
+    }
+    void visitFunction(const novasyntax::FunctionDeclaration& func) {
+        functions++;
+        visitChildren(func);
+    }
+};
+
+// Returns a value per node; visitVariable/visitFunction use the defaults
+struct ExpressionHeight : novasyntax::AstVisitor<ExpressionHeight, int> {
+    int visitExpression(const novasyntax::Expression& expr) {
+        int height = 0;
+        if (expr.left) height = std::max(height, visit(*expr.left));
+        if (expr.right) height = std::max(height, visit(*expr.right));
+        for (const auto& argument : expr.arguments) height = std::max(height, visit(*argument));
+        return height + 1;
+    }
+};
+
+// Bottom-up constant folding over the flat array with a value stack
+struct ConstantFolder {
+    std::vector<std::optional<double>> values;
+    std::vector<std::pair<uint32_t, double>> folded;
+
+    void visit(const FlatNode& node, uint32_t index) {
+        if (node.kind == FlatNodeKind::NUMBER) {
+            values.push_back(std::stod(std::string(node.value)));
+            return;
+        }
+        if (node.kind == FlatNodeKind::BINARY) {
+            auto right = values.back();
+            values.pop_back();
+            auto left = values.back();
+            values.pop_back();
+            std::optional<double> result;
+            if (left && right) {
+                switch (static_cast<novasyntax::TokenType>(node.op)) {
+                    case novasyntax::TokenType::PLUS: result = *left + *right; break;
+                    case novasyntax::TokenType::MINUS: result = *left - *right; break;
+                    case novasyntax::TokenType::MULTIPLY: result = *left * *right; break;
+                    default: result = *left / *right; break;
+                }
+                folded.emplace_back(index, *result);
+            }
+            values.push_back(result);
+            return;
+        }
+        values.resize(values.size() - node.child_count);
+        values.push_back(std::nullopt);
+    }
+};
+
+struct NodeCounter {
+    uint32_t counts[8] = {};
+
+    void visit(const FlatNode& node, uint32_t) { counts[static_cast<int>(node.kind)]++; }
+};
+
+} // namespace
+
+TEST(FlatAstTest, VisitorDispatchesWithoutCasts) {
+    auto program = parseSource(R"(
+        func area(w, h) {
+            let size = w * h
+            return size
+        }
+        let total = area(2, 3 + 4) * 2
+    )");
+
+    KindCounter counter;
+    counter.visitProgram(program);
+    EXPECT_EQ(counter.functions, 1);
+    EXPECT_EQ(counter.variables, 2);
+    // w * h (3), size, area(2, 3 + 4) * 2 (7)
+    EXPECT_EQ(counter.expressions, 11);
+
+    ExpressionHeight height;
+    EXPECT_EQ(height.visit(*program[0]), 0);
+    auto* total = static_cast<novasyntax::VariableDeclaration*>(program[1].get());
+    EXPECT_EQ(height.visit(*total->initializer), 4);
+}
+
+TEST(FlatAstTest, PostOrderLayout) {
+    auto program = parseSource("let a = f(1, 2 * x)\nlet b = a");
+    novasyntax::FlatAst ast(program);
+
+    ASSERT_EQ(ast.size(), 8u);
+    const FlatNodeKind expected[] = {
+        FlatNodeKind::NUMBER, FlatNodeKind::NUMBER, FlatNodeKind::IDENTIFIER, FlatNodeKind::BINARY,
+        FlatNodeKind::CALL, FlatNodeKind::VARIABLE, FlatNodeKind::IDENTIFIER, FlatNodeKind::VARIABLE
+    };
+    for (uint32_t i = 0; i < ast.size(); ++i) {
+        EXPECT_EQ(ast[i].kind, expected[i]) << "node " << i;
+    }
+
+    EXPECT_EQ(ast.roots(), (std::vector<uint32_t>{5, 7}));
+    EXPECT_EQ(ast[5].value, "a");
+    EXPECT_EQ(ast[5].subtree_size, 6u);
+    EXPECT_EQ(ast.subtreeBegin(5), 0u);
+    EXPECT_EQ(static_cast<novasyntax::TokenType>(ast[3].op), novasyntax::TokenType::MULTIPLY);
+    EXPECT_EQ(ast[3].source->line, 1);
+
+    std::vector<uint32_t> children;
+    ast.children(4, children);
+    EXPECT_EQ(children, (std::vector<uint32_t>{0, 3}));
+    ast.children(3, children);
+    EXPECT_EQ(children, (std::vector<uint32_t>{1, 2}));
+}
+
+TEST(FlatAstTest, FunctionLayout) {
+    auto program = parseSource("func f(a, b) {\n    log(a)\n    return a + b\n}\nfunc g() {}");
+    novasyntax::FlatAst ast(program);
+
+    ASSERT_EQ(ast.roots().size(), 2u);
+    const FlatNode& f = ast[ast.roots()[0]];
+    EXPECT_EQ(f.kind, FlatNodeKind::FUNCTION);
+    EXPECT_EQ(f.extra, 2u);
+    EXPECT_EQ(f.flags, novasyntax::kFlatNodeHasBody);
+    EXPECT_EQ(f.child_count, 4u);
+
+    std::vector<uint32_t> children;
+    ast.children(ast.roots()[0], children);
+    ASSERT_EQ(children.size(), 4u);
+    EXPECT_EQ(ast[children[0]].kind, FlatNodeKind::PARAMETER);
+    EXPECT_EQ(ast[children[1]].value, "b");
+    EXPECT_EQ(ast[children[1]].extra, 1u);
+    EXPECT_EQ(ast[children[2]].kind, FlatNodeKind::CALL);
+    EXPECT_EQ(ast[children[3]].kind, FlatNodeKind::BINARY);
+
+    const FlatNode& g = ast[ast.roots()[1]];
+    EXPECT_EQ(g.child_count, 0u);
+    EXPECT_EQ(g.flags, 0);
+    EXPECT_EQ(g.subtree_size, 1u);
+}
+
+TEST(FlatAstTest, FusedPassesShareOneWalk) {
+    auto program = parseSource("let a = (1 + 2) * 4\nlet b = a * (10 - 4 / 2)");
+    novasyntax::FlatAst ast(program);
+
+    ConstantFolder folder;
+    NodeCounter counter;
+    novasyntax::runFusedPasses(ast, folder, counter);
+
+    // Everything but 'a * ...' folds
+    ASSERT_EQ(folder.folded.size(), 4u);
+    EXPECT_DOUBLE_EQ(folder.folded[1].second, 12);
+    EXPECT_DOUBLE_EQ(folder.folded[3].second, 8);
+    EXPECT_EQ(folder.values.size(), ast.roots().size());
+
+    EXPECT_EQ(counter.counts[static_cast<int>(FlatNodeKind::NUMBER)], 6u);
+    EXPECT_EQ(counter.counts[static_cast<int>(FlatNodeKind::BINARY)], 5u);
+    EXPECT_EQ(counter.counts[static_cast<int>(FlatNodeKind::VARIABLE)], 2u);
+
+    // Rebuilding drops the previous program's nodes
+    auto other = parseSource("let c = 1");
+    ast.build(other);
+    EXPECT_EQ(ast.size(), 2u);
+    EXPECT_EQ(ast.roots(), (std::vector<uint32_t>{1}));
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "format/formatter.h"
+
+namespace {
+
+std::string formatOrFail(novasyntax::Formatter& formatter, const std::string& source) {
+    std::string out;
+    std::string error;
+    EXPECT_TRUE(formatter.formatSource(source, out, error)) << error;
+    return out;
+}
+
+} // namespace
+
+TEST(FormatterTest, CanonicalLayout) {
+    novasyntax::Formatter formatter;
+    std::string formatted = formatOrFail(formatter,
+        "let  base=10 let label = \"total\"\n"
+        "func   calculate(x,y){let result=x+y*base   return result}"
+        "let answer=calculate( 1 ,2 )");
+
+    EXPECT_EQ(formatted,
+        "let base = 10\n"
+        "let label = \"total\"\n"
+        "\n"
+        "func calculate(x, y) {\n"
+        "    let result = x + y * base\n"
+        "    return result\n"
+        "}\n"
+        "\n"
+        "let answer = calculate(1, 2)\n");
+}
+
+TEST(FormatterTest, ParenthesesFollowPrecedence) {
+    novasyntax::Formatter formatter;
+    EXPECT_EQ(formatOrFail(formatter, "let a = ((x + y)) * (z)"), "let a = (x + y) * z\n");
+    EXPECT_EQ(formatOrFail(formatter, "let b = x - (y - z)"), "let b = x - (y - z)\n");
+    EXPECT_EQ(formatOrFail(formatter, "let c = (x - y) - z"), "let c = x - y - z\n");
+    EXPECT_EQ(formatOrFail(formatter, "let d = x / (y * z)"), "let d = x / (y * z)\n");
+}
+
+TEST(FormatterTest, Idempotent) {
+    const char* sources[] = {
+        "func add(x, y) { return x + y }",
+        "func f(a) { g(a) h(a, 0xAF) a * (a - 0b1010) } let s = \"hi\" + \"there\"",
+        "func empty() {} func local() { let t = 42.5e-2 } x + 1",
+    };
+
+    novasyntax::Formatter formatter;
+    for (const char* source : sources) {
+        std::string once = formatOrFail(formatter, source);
+        std::string twice = formatOrFail(formatter, once);
+        EXPECT_EQ(once, twice) << "Source: " << source;
+    }
+}
+
+TEST(FormatterTest, RejectsUnparsableSource) {
+    novasyntax::Formatter formatter;
+    std::string out = "unchanged";
+    std::string error;
+    EXPECT_FALSE(formatter.formatSource("let x = )", out, error));
+    EXPECT_EQ(out, "unchanged");
+    EXPECT_FALSE(error.empty());
+}
+
+TEST(FormatterTest, KeepsComments) {
+    novasyntax::Formatter formatter;
+    std::string source =
+        "// Scaling helpers\n"
+        "\n"
+        "/* multiplies\n"
+        "   x */\n"
+        "func scale(x,factor){ // opens\n"
+        "  // leading\n"
+        "  let r=x*factor   // trailing   \n"
+        "  return r+1\n"
+        "  // before brace\n"
+        "}\n"
+        "let a=scale(1,2) /* inline */\n"
+        "// tail";
+
+    std::string formatted = formatOrFail(formatter, source);
+    EXPECT_EQ(formatted,
+        "// Scaling helpers\n"
+        "\n"
+        "/* multiplies\n"
+        "   x */\n"
+        "func scale(x, factor) { // opens\n"
+        "    // leading\n"
+        "    let r = x * factor // trailing\n"
+        "    return r + 1\n"
+        "    // before brace\n"
+        "}\n"
+        "\n"
+        "let a = scale(1, 2) /* inline */\n"
+        "// tail\n");
+    EXPECT_EQ(formatOrFail(formatter, formatted), formatted);
+
+    // A comment inside an otherwise empty body opens it up
+    EXPECT_EQ(formatOrFail(formatter, "func f() {\n// todo\n}"), "func f() {\n    // todo\n}\n");
+}
+
+TEST(FormatterTest, CommentsAfterLineCommentGetOwnLine) {
+    const char* sources[] = {
+        "let v = f(1, // a\n2) /* m\n n */\nlet w = 2\n",
+        "let v = f(1, // a\n2) /* b */\nlet w = 2\n",
+        "let v = f(1, /* m\n n */ 2) // c\nfunc g(x) { x }\n",
+        "func h(x) {\n  let r = f(x, // a\nx) /* b */ /* c */\n  return r\n}\n",
+    };
+
+    novasyntax::Formatter formatter;
+    for (const char* source : sources) {
+        // formatSource parses its input, so each pass checks the previous one
+        std::string once = formatOrFail(formatter, source);
+        std::string twice = formatOrFail(formatter, once);
+        EXPECT_EQ(once, twice) << "Source: " << source;
+    }
+
+    EXPECT_EQ(formatOrFail(formatter, sources[0]),
+        "let v = f(1, 2) // a\n"
+        "/* m\n n */\n"
+        "let w = 2\n");
+    EXPECT_EQ(formatOrFail(formatter, sources[1]),
+        "let v = f(1, 2) // a\n"
+        "/* b */\n"
+        "let w = 2\n");
+}
+
+TEST(FormatterTest, KeepsBlankLineAfterFileHeader) {
+    novasyntax::Formatter formatter;
+    std::string formatted = formatOrFail(formatter, "// header\n\nfunc f(x) { x }");
+    EXPECT_EQ(formatted, "// header\n\nfunc f(x) {\n    return x\n}\n");
+    EXPECT_EQ(formatOrFail(formatter, formatted), formatted);
+
+    EXPECT_EQ(formatOrFail(formatter, "/* license */\n\n\nlet x = 1"), "/* license */\n\nlet x = 1\n");
+    EXPECT_EQ(formatOrFail(formatter, "// doc\nfunc f(x) { x }"), "// doc\nfunc f(x) {\n    return x\n}\n");
+}
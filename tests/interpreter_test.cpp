@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "runtime/interpreter.h"
+#include "test_support.h"
+
+namespace {
+
+using novasyntax::test::parseSource;
+
+double number(const novasyntax::Value& value) {
+    EXPECT_TRUE(std::holds_alternative<double>(value)) << novasyntax::valueToString(value);
+    auto* result = std::get_if<double>(&value);
+    return result ? *result : 0;
+}
+
+} // namespace
+
+TEST(InterpreterTest, NumberLiterals) {
+    EXPECT_DOUBLE_EQ(novasyntax::numberLiteralValue("42"), 42);
+    EXPECT_DOUBLE_EQ(novasyntax::numberLiteralValue("42.5e-2"), 0.425);
+    EXPECT_DOUBLE_EQ(novasyntax::numberLiteralValue("0xAF"), 175);
+    EXPECT_DOUBLE_EQ(novasyntax::numberLiteralValue("0b1010"), 10);
+}
+
+TEST(InterpreterTest, EvaluatesFunctionsAndGlobals) {
+    auto program = parseSource(R"(
+        let answer = scale(2, 21) - (1 - 2)
+        func scale(x, factor) {
+            let x = x * factor
+            return x
+        }
+        func apply(f, v) { f(v, 2) }
+        let twice = apply(scale, 8)
+        let greeting = "Hello, " + "Nova"
+    )");
+
+    novasyntax::Interpreter interpreter(program);
+    EXPECT_DOUBLE_EQ(number(*interpreter.global("answer")), 43);
+    EXPECT_DOUBLE_EQ(number(*interpreter.global("twice")), 16);
+    EXPECT_EQ(std::get<std::string>(*interpreter.global("greeting")), "Hello, Nova");
+    EXPECT_EQ(interpreter.global("x"), nullptr);
+
+    EXPECT_DOUBLE_EQ(number(interpreter.call("scale", {3.0, 0.5})), 1.5);
+    EXPECT_DOUBLE_EQ(number(interpreter.call("apply", {*interpreter.global("scale"), 5.0})), 10);
+}
+
+TEST(InterpreterTest, FunctionWithoutResult) {
+    auto program = parseSource("func nothing() {}\nlet x = nothing()");
+    novasyntax::Interpreter interpreter(program);
+    EXPECT_TRUE(std::holds_alternative<novasyntax::NoValue>(*interpreter.global("x")));
+}
+
+TEST(InterpreterTest, RuntimeErrors) {
+    auto program = parseSource(R"(
+        func half(x) { x / 2 }
+        func loop(x) { loop(x) }
+        func bad(x) { x - "one" }
+    )");
+    novasyntax::Interpreter interpreter(program);
+
+    EXPECT_THROW(interpreter.call("missing", {}), std::runtime_error);
+    EXPECT_THROW(interpreter.call("half", {1.0, 2.0}), std::runtime_error);
+    EXPECT_THROW(interpreter.call("bad", {1.0}), std::runtime_error);
+    try {
+        interpreter.call("loop", {1.0});
+        FAIL() << "Expected the call depth limit";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("Maximum call depth"), std::string::npos);
+    }
+
+    // Frames are unwound, so later calls still work
+    EXPECT_DOUBLE_EQ(number(interpreter.call("half", {5.0})), 2.5);
+
+    EXPECT_THROW(novasyntax::Interpreter(parseSource("let y = z + 1")), std::runtime_error);
+}
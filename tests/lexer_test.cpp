@@ -122,6 +122,91 @@ TEST(LexerTest, ComplexTokenization) {
     }
 }
 
+TEST(LexerTest, ColumnsAfterNewline) {
+    std::string source = "let x = 1\n  let y = \"two\"";
+    novasyntax::Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 9);
+    EXPECT_EQ(tokens[4].literal, "let");
+    EXPECT_EQ(tokens[4].line, 2);
+    EXPECT_EQ(tokens[4].column, 3);
+    EXPECT_EQ(tokens[7].literal, "two");
+    EXPECT_EQ(tokens[7].column, 11);
+}
+
+TEST(LexerTest, ColumnsAfterLeadingZero) {
+    novasyntax::Lexer lexer("let a = 0 + bb\nlet c = 0.5 * 0e1 / d");
+    auto tokens = lexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 15);
+    EXPECT_EQ(tokens[3].column, 9);   // 0
+    EXPECT_EQ(tokens[4].column, 11);  // +
+    EXPECT_EQ(tokens[5].column, 13);  // bb
+    EXPECT_EQ(tokens[9].column, 9);   // 0.5
+    EXPECT_EQ(tokens[10].column, 13); // *
+    EXPECT_EQ(tokens[11].column, 15); // 0e1
+    EXPECT_EQ(tokens[13].column, 21); // d
+}
+
+TEST(LexerTest, SkipsComments) {
+    std::string source =
+        "// header\n"
+        "let a = 1 / 2 // half\n"
+        "/* block\n"
+        "   comment */ let b = a /* inline */ * 2\n"
+        "// last line without newline";
+    novasyntax::Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    std::vector<std::string> literals;
+    for (const auto& token : tokens) literals.push_back(token.literal);
+    EXPECT_EQ(literals, (std::vector<std::string>{
+        "let", "a", "=", "1", "/", "2", "let", "b", "=", "a", "*", "2", "<EOF>"}));
+    EXPECT_TRUE(lexer.trivia().empty());
+
+    // Positions after a block comment spanning lines
+    EXPECT_EQ(tokens[6].line, 4);
+    EXPECT_EQ(tokens[6].column, 15);
+    EXPECT_EQ(tokens[10].column, 38);
+
+    novasyntax::Lexer unterminated("let a = 1 /* open");
+    EXPECT_THROW(unterminated.tokenize(), std::runtime_error);
+}
+
+TEST(LexerTest, PreservesCommentTrivia) {
+    std::string source =
+        "// header\n"
+        "func f(x) { // opens\n"
+        "    return x /* result */\n"
+        "}\n"
+        "/* tail */";
+    novasyntax::Lexer lexer(source, novasyntax::CommentMode::PRESERVE);
+    auto tokens = lexer.tokenize();
+    const auto& trivia = lexer.trivia();
+    ASSERT_EQ(trivia.size(), 4u);
+
+    auto text = [&](const novasyntax::Trivia& t) { return source.substr(t.begin, t.end - t.begin); };
+
+    EXPECT_EQ(text(trivia[0]), "// header");
+    EXPECT_FALSE(trivia[0].trailing);
+    EXPECT_EQ(tokens[trivia[0].token].literal, "func");
+
+    EXPECT_EQ(text(trivia[1]), "// opens");
+    EXPECT_TRUE(trivia[1].trailing);
+    EXPECT_EQ(tokens[trivia[1].token].literal, "{");
+    EXPECT_EQ(trivia[1].line, 2);
+    EXPECT_EQ(trivia[1].column, 13);
+
+    EXPECT_EQ(text(trivia[2]), "/* result */");
+    EXPECT_TRUE(trivia[2].trailing);
+    EXPECT_EQ(tokens[trivia[2].token].literal, "x");
+
+    EXPECT_EQ(text(trivia[3]), "/* tail */");
+    EXPECT_FALSE(trivia[3].trailing);
+    EXPECT_EQ(tokens[trivia[3].token].type, novasyntax::TokenType::EOF_);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,333 @@
+#include <gtest/gtest.h>
+#include "lsp/document_analysis.h"
+#include "lsp/json.h"
+#include "lsp/lsp_server.h"
+#include <sstream>
+
+using novasyntax::lsp::Json;
+
+namespace {
+
+const char* kUri = "file:///workspace/scale.nova";
+
+const char* kSource =
+    "func scale(x, factor) {\n"
+    "    let result = x * factor\n"
+    "    return result\n"
+    "}\n"
+    "let bad = \"str\" + 1\n";
+
+// Scripted stdio client: frames a sequence of messages, runs the server on
+// them and splits its output back into messages
+class ScriptedClient {
+public:
+    void request(int id, const std::string& method, Json params = Json::Object{}) {
+        Json message;
+        message.set("jsonrpc", "2.0");
+        message.set("id", id);
+        message.set("method", method);
+        message.set("params", std::move(params));
+        frame(message);
+    }
+
+    void notify(const std::string& method, Json params = Json::Object{}) {
+        Json message;
+        message.set("jsonrpc", "2.0");
+        message.set("method", method);
+        message.set("params", std::move(params));
+        frame(message);
+    }
+
+    // Append raw bytes, for malformed framing
+    void raw(const std::string& text) { script_ += text; }
+
+    int run() {
+        std::istringstream in(script_);
+        std::ostringstream out;
+        novasyntax::lsp::LspServer server(in, out, log_);
+        int exit_code = server.run();
+
+        std::string output = out.str();
+        size_t pos = 0;
+        while ((pos = output.find("Content-Length: ", pos)) != std::string::npos) {
+            size_t length = std::stoul(output.substr(pos + 16));
+            size_t body = output.find("\r\n\r\n", pos) + 4;
+            messages_.push_back(Json::parse(output.substr(body, length)));
+            pos = body + length;
+        }
+        return exit_code;
+    }
+
+    const Json* response(int id) const {
+        for (const auto& message : messages_) {
+            if (message["id"].isNumber() && message["id"].asInt() == id) return &message;
+        }
+        return nullptr;
+    }
+
+    std::vector<const Json*> diagnostics() const {
+        std::vector<const Json*> published;
+        for (const auto& message : messages_) {
+            if (message["method"].asString() == "textDocument/publishDiagnostics") {
+                published.push_back(&message["params"]);
+            }
+        }
+        return published;
+    }
+
+    std::string log() const { return log_.str(); }
+
+private:
+    std::string script_;
+    std::vector<Json> messages_;
+    std::ostringstream log_;
+
+    void frame(const Json& message) {
+        std::string body = message.dump();
+        script_.append("Content-Length: ").append(std::to_string(body.size()));
+        script_.append("\r\n\r\n").append(body);
+    }
+};
+
+Json textDocument(const std::string& uri) {
+    Json document;
+    document.set("uri", uri);
+    Json params;
+    params.set("textDocument", std::move(document));
+    return params;
+}
+
+Json didOpen(const std::string& text, int version) {
+    Json document;
+    document.set("uri", kUri);
+    document.set("languageId", "novasyntax");
+    document.set("version", version);
+    document.set("text", text);
+    Json params;
+    params.set("textDocument", std::move(document));
+    return params;
+}
+
+Json didChange(int version, int line, int from, int to, const std::string& text) {
+    Json document;
+    document.set("uri", kUri);
+    document.set("version", version);
+
+    Json start;
+    start.set("line", line);
+    start.set("character", from);
+    Json end;
+    end.set("line", line);
+    end.set("character", to);
+    Json range;
+    range.set("start", std::move(start));
+    range.set("end", std::move(end));
+
+    Json change;
+    change.set("range", std::move(range));
+    change.set("text", text);
+    Json changes;
+    changes.push(std::move(change));
+
+    Json params;
+    params.set("textDocument", std::move(document));
+    params.set("contentChanges", std::move(changes));
+    return params;
+}
+
+Json positionParams(int line, int character) {
+    Json params = textDocument(kUri);
+    Json position;
+    position.set("line", line);
+    position.set("character", character);
+    params.set("position", std::move(position));
+    return params;
+}
+
+} // namespace
+
+TEST(JsonTest, RoundTrip) {
+    Json value = Json::parse(R"({"a": [1, -2.5, true, null], "s": "line\n\"quoted\" é"})");
+    EXPECT_EQ(value["a"].asArray().size(), 4);
+    EXPECT_EQ(value["a"].asArray()[0].asInt(), 1);
+    EXPECT_DOUBLE_EQ(value["a"].asArray()[1].asNumber(), -2.5);
+    EXPECT_EQ(value["s"].asString(), "line\n\"quoted\" \xc3\xa9");
+    EXPECT_TRUE(value["missing"].isNull());
+    EXPECT_EQ(Json::parse(value.dump()).dump(), value.dump());
+    EXPECT_THROW(Json::parse("{\"a\": }"), std::runtime_error);
+
+    Json range = Json::parse(R"({"big": 1e20, "small": -1e20, "max": 2147483647})");
+    EXPECT_EQ(range["big"].asInt(-1), -1);
+    EXPECT_EQ(range["small"].asInt(-1), -1);
+    EXPECT_EQ(range["max"].asInt(), 2147483647);
+}
+
+TEST(DocumentAnalysisTest, SemanticTokensAndDefinitions) {
+    std::atomic<bool> cancelled{false};
+    novasyntax::lsp::DocumentAnalysis analysis;
+    ASSERT_TRUE(novasyntax::lsp::analyzeDocument(kSource, cancelled, analysis));
+
+    // func (keyword), then scale (function declaration) five columns later
+    ASSERT_GE(analysis.semantic_tokens.size(), 10);
+    std::vector<uint32_t> first(analysis.semantic_tokens.begin(), analysis.semantic_tokens.begin() + 10);
+    EXPECT_EQ(first, (std::vector<uint32_t>{0, 0, 4, 0, 0, 0, 5, 5, 1, 1}));
+
+    // 'factor' in the body resolves to the parameter
+    int use = novasyntax::lsp::symbolAt(analysis, 1, 22);
+    ASSERT_GE(use, 0);
+    const auto& definition = analysis.symbols[analysis.symbols[use].definition];
+    EXPECT_EQ(definition.line, 0);
+    EXPECT_EQ(definition.column, 14);
+    EXPECT_EQ(definition.kind, novasyntax::lsp::SemanticTokenType::PARAMETER);
+
+    ASSERT_EQ(analysis.diagnostics.size(), 1);
+    EXPECT_EQ(analysis.diagnostics[0].line, 4);
+    EXPECT_EQ(analysis.diagnostics[0].column, 10);
+    EXPECT_EQ(analysis.diagnostics[0].length, 5);  // "str", quotes included
+}
+
+TEST(DocumentAnalysisTest, DefinitionAfterZeroLiteral) {
+    std::atomic<bool> cancelled{false};
+    novasyntax::lsp::DocumentAnalysis analysis;
+    ASSERT_TRUE(novasyntax::lsp::analyzeDocument("let bb = 2\nlet a = 0 + bb", cancelled, analysis));
+
+    int use = novasyntax::lsp::symbolAt(analysis, 1, 12);
+    ASSERT_GE(use, 0);
+    const auto& definition = analysis.symbols[analysis.symbols[use].definition];
+    EXPECT_EQ(definition.line, 0);
+    EXPECT_EQ(definition.column, 4);
+}
+
+TEST(DocumentAnalysisTest, StopsWhenCancelled) {
+    std::atomic<bool> cancelled{true};
+    novasyntax::lsp::DocumentAnalysis analysis;
+    EXPECT_FALSE(novasyntax::lsp::analyzeDocument(kSource, cancelled, analysis));
+}
+
+TEST(LspServerTest, ScriptedSession) {
+    ScriptedClient client;
+    client.request(1, "initialize");
+    client.notify("initialized");
+    client.notify("textDocument/didOpen", didOpen(kSource, 1));
+    client.request(2, "textDocument/semanticTokens/full", textDocument(kUri));
+    // Fix the type error: 1 -> "1"
+    client.notify("textDocument/didChange", didChange(2, 4, 18, 19, "\"1\""));
+    client.request(3, "textDocument/definition", positionParams(2, 12));
+    // Rename 'result' at its use; only the tail of the token data changes
+    client.notify("textDocument/didChange", didChange(3, 2, 11, 17, "factor"));
+    client.request(4, "textDocument/semanticTokens/full/delta", [] {
+        Json params = textDocument(kUri);
+        params.set("previousResultId", "1");
+        return params;
+    }());
+    client.request(5, "novasyntax/latencyStats");
+    client.request(6, "no/suchMethod");
+    client.request(7, "shutdown");
+    client.notify("exit");
+
+    EXPECT_EQ(client.run(), 0);
+
+    const Json* initialize = client.response(1);
+    ASSERT_NE(initialize, nullptr);
+    EXPECT_TRUE(initialize->operator[]("result")["capabilities"]["definitionProvider"].asBool());
+    EXPECT_TRUE(initialize->operator[]("result")["capabilities"]["semanticTokensProvider"]["full"]["delta"].asBool());
+
+    const Json* tokens = client.response(2);
+    ASSERT_NE(tokens, nullptr);
+    EXPECT_EQ((*tokens)["result"]["resultId"].asString(), "1");
+    EXPECT_EQ((*tokens)["result"]["data"].asArray().size() % 5, 0);
+
+    // 'result' in 'return result' goes to its let declaration
+    const Json* definition = client.response(3);
+    ASSERT_NE(definition, nullptr);
+    EXPECT_EQ((*definition)["result"]["uri"].asString(), kUri);
+    EXPECT_EQ((*definition)["result"]["range"]["start"]["line"].asInt(), 1);
+    EXPECT_EQ((*definition)["result"]["range"]["start"]["character"].asInt(), 8);
+
+    const Json* delta = client.response(4);
+    ASSERT_NE(delta, nullptr);
+    const auto& edits = (*delta)["result"]["edits"].asArray();
+    ASSERT_EQ(edits.size(), 1);
+    EXPECT_GT(edits[0]["start"].asInt(), 0);
+    EXPECT_LT(edits[0]["data"].asArray().size(), (*tokens)["result"]["data"].asArray().size());
+
+    const Json* stats = client.response(5);
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ((*stats)["result"]["methods"]["textDocument/definition"]["count"].asInt(), 1);
+    EXPECT_GE((*stats)["result"]["methods"]["analysis"]["count"].asInt(), 2);
+
+    const Json* unknown = client.response(6);
+    ASSERT_NE(unknown, nullptr);
+    EXPECT_EQ((*unknown)["error"]["code"].asInt(), -32601);
+
+    // Version 1 has the "str" + 1 error; the last published version is clean
+    auto published = client.diagnostics();
+    ASSERT_GE(published.size(), 2);
+    EXPECT_EQ((*published.front())["version"].asInt(), 1);
+    EXPECT_EQ((*published.front())["diagnostics"].asArray().size(), 1);
+    EXPECT_EQ((*published.back())["version"].asInt(), 3);
+    EXPECT_TRUE((*published.back())["diagnostics"].asArray().empty());
+
+    EXPECT_NE(client.log().find("textDocument/semanticTokens/full"), std::string::npos);
+}
+
+TEST(LspServerTest, NewerVersionsSupersedeOlderAnalyses) {
+    ScriptedClient client;
+    client.request(1, "initialize");
+    client.notify("textDocument/didOpen", didOpen(kSource, 1));
+    for (int version = 2; version <= 50; ++version) {
+        std::string name = std::to_string(version);
+        name.insert(name.begin(), 'v');
+        client.notify("textDocument/didChange", didChange(version, 4, 4, 7, name));
+    }
+    client.request(2, "textDocument/semanticTokens/full", textDocument(kUri));
+    client.request(3, "shutdown");
+    client.notify("exit");
+
+    EXPECT_EQ(client.run(), 0);
+
+    // Published versions only ever move forward and end at the latest one
+    auto published = client.diagnostics();
+    ASSERT_FALSE(published.empty());
+    int previous = 0;
+    for (const Json* params : published) {
+        EXPECT_GT((*params)["version"].asInt(), previous);
+        previous = (*params)["version"].asInt();
+    }
+    EXPECT_EQ(previous, 50);
+}
+
+TEST(LspServerTest, SurvivesMalformedContentLength) {
+    ScriptedClient client;
+    client.raw("Content-Length: abc\r\n\r\n{}");
+    client.request(1, "initialize");
+    client.raw("Content-Length: 99999999999999999999999\r\n\r\n");
+    client.request(2, "shutdown");
+    // Too large to buffer; skipped rather than allocated
+    client.raw("Content-Length: 100000000\r\n\r\n");
+
+    EXPECT_EQ(client.run(), 0);
+    EXPECT_NE(client.response(1), nullptr);
+    EXPECT_NE(client.response(2), nullptr);
+    EXPECT_NE(client.log().find("invalid Content-Length 'abc'"), std::string::npos);
+    EXPECT_NE(client.log().find("dropped message of 100000000 bytes"), std::string::npos);
+}
+
+TEST(LspServerTest, ClosedDocumentsKeepNoDiagnostics) {
+    ScriptedClient client;
+    client.request(1, "initialize");
+    for (int version = 1; version <= 50; ++version) {
+        client.notify("textDocument/didOpen", didOpen(kSource, version));
+        client.notify("textDocument/didClose", textDocument(kUri));
+    }
+    client.request(2, "shutdown");
+    client.notify("exit");
+
+    EXPECT_EQ(client.run(), 0);
+
+    // Whatever analyses finished, the close clears the document last
+    auto published = client.diagnostics();
+    ASSERT_FALSE(published.empty());
+    EXPECT_FALSE(published.back()->contains("version"));
+    EXPECT_TRUE((*published.back())["diagnostics"].asArray().empty());
+}
@@ -119,7 +119,65 @@ TEST(ParserTest, ErrorRecovery) {
     });
 }
 
-int main(int argc, char **argv) {
-    testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
+
+TEST(ParserTest, BinaryExpressionPrecedence) {
+    novasyntax::Lexer lexer("x + y * 2");
+    novasyntax::Parser parser(lexer.tokenize());
+    auto ast = parser.parse();
+
+    auto* expr = dynamic_cast<novasyntax::Expression*>(ast.get());
+    ASSERT_NE(expr, nullptr);
+    EXPECT_EQ(expr->type, novasyntax::Expression::Type::BINARY);
+    EXPECT_EQ(expr->op, novasyntax::TokenType::PLUS);
+    ASSERT_NE(expr->left, nullptr);
+    EXPECT_EQ(expr->left->value, "x");
+    ASSERT_NE(expr->right, nullptr);
+    EXPECT_EQ(expr->right->op, novasyntax::TokenType::MULTIPLY);
+    EXPECT_EQ(expr->right->left->value, "y");
+    EXPECT_EQ(expr->right->right->value, "2");
+}
+
+TEST(ParserTest, FunctionBodyWithStatements) {
+    novasyntax::Lexer lexer(R"(
+        func calculate(x, y) {
+            let result = x + y
+            let message = "Calculation complete"
+            return result
+        }
+    )");
+    novasyntax::Parser parser(lexer.tokenize());
+    auto ast = parser.parse();
+
+    auto* func_decl = dynamic_cast<novasyntax::FunctionDeclaration*>(ast.get());
+    ASSERT_NE(func_decl, nullptr);
+    EXPECT_EQ(func_decl->statements.size(), 2);
+    EXPECT_NE(dynamic_cast<novasyntax::VariableDeclaration*>(func_decl->statements[0].get()), nullptr);
+
+    auto* body_expr = dynamic_cast<novasyntax::Expression*>(func_decl->body.get());
+    ASSERT_NE(body_expr, nullptr);
+    EXPECT_EQ(body_expr->type, novasyntax::Expression::Type::IDENTIFIER);
+    EXPECT_EQ(body_expr->value, "result");
+    EXPECT_EQ(func_decl->line, 2);
+}
+
+TEST(ParserTest, ProgramWithCallsAndRecovery) {
+    novasyntax::Lexer lexer(R"(
+        func square(n) { n * n }
+        let broken = )
+        let area = square(3)
+    )");
+    novasyntax::Parser parser(lexer.tokenize(), false);
+    auto program = parser.parseProgram();
+
+    EXPECT_TRUE(parser.hadError());
+    ASSERT_EQ(program.size(), 3);
+
+    auto* area = dynamic_cast<novasyntax::VariableDeclaration*>(program[2].get());
+    ASSERT_NE(area, nullptr);
+    auto* call = dynamic_cast<novasyntax::Expression*>(area->initializer.get());
+    ASSERT_NE(call, nullptr);
+    EXPECT_EQ(call->type, novasyntax::Expression::Type::CALL);
+    EXPECT_EQ(call->value, "square");
+    ASSERT_EQ(call->arguments.size(), 1);
+    EXPECT_EQ(call->arguments[0]->value, "3");
 }
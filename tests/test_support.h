@@ -0,0 +1,21 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include "lexer.hpp"
+#include "parser/parser.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace novasyntax::test {
+
+// Lex and parse `source`, failing the current test on a parse error
+inline std::vector<std::unique_ptr<ASTNode>> parseSource(const std::string& source) {
+    Lexer lexer(source);
+    Parser parser(lexer.tokenize(), false);
+    auto program = parser.parseProgram();
+    EXPECT_FALSE(parser.hadError());
+    return program;
+}
+
+} // namespace novasyntax::test
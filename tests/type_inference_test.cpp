@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "semantic/type_inference.h"
+#include "test_support.h"
+
+using novasyntax::test::parseSource;
+
+TEST(TypeInferenceTest, InfersFunctionSignature) {
+    auto program = parseSource(R"(
+        func scale(x, factor) {
+            let result = x * factor
+            return result
+        }
+        let answer = scale(2, 21)
+    )");
+
+    novasyntax::TypeInference inference;
+    auto diagnostics = inference.run(program);
+    EXPECT_TRUE(diagnostics.empty());
+
+    auto* func = dynamic_cast<novasyntax::FunctionDeclaration*>(program[0].get());
+    ASSERT_NE(func, nullptr);
+    EXPECT_EQ(func->inferred_type, novasyntax::ValueType::FUNCTION);
+    ASSERT_EQ(func->parameter_types.size(), 2);
+    EXPECT_EQ(func->parameter_types[0], novasyntax::ValueType::NUMBER);
+    EXPECT_EQ(func->parameter_types[1], novasyntax::ValueType::NUMBER);
+    EXPECT_EQ(func->return_type, novasyntax::ValueType::NUMBER);
+
+    auto* answer = dynamic_cast<novasyntax::VariableDeclaration*>(program[1].get());
+    ASSERT_NE(answer, nullptr);
+    EXPECT_EQ(answer->inferred_type, novasyntax::ValueType::NUMBER);
+}
+
+TEST(TypeInferenceTest, PropagatesThroughCallers) {
+    // 'greet' alone is generic in '+'; the call site fixes it to strings
+    auto program = parseSource(R"(
+        let title = greet("Hello, ", "NovaSyntax")
+        func greet(prefix, name) { prefix + name }
+    )");
+
+    novasyntax::TypeInference inference;
+    EXPECT_TRUE(inference.run(program).empty());
+
+    auto* greet = dynamic_cast<novasyntax::FunctionDeclaration*>(program[1].get());
+    ASSERT_NE(greet, nullptr);
+    EXPECT_EQ(greet->return_type, novasyntax::ValueType::STRING);
+
+    auto* body = dynamic_cast<novasyntax::Expression*>(greet->body.get());
+    ASSERT_NE(body, nullptr);
+    EXPECT_EQ(body->inferred_type, novasyntax::ValueType::STRING);
+    EXPECT_EQ(body->left->inferred_type, novasyntax::ValueType::STRING);
+}
+
+TEST(TypeInferenceTest, ReportsStringPlusNumber) {
+    auto program = parseSource("let bad = \"str\" + 1");
+
+    novasyntax::TypeInference inference;
+    auto diagnostics = inference.run(program);
+    ASSERT_EQ(diagnostics.size(), 1);
+    EXPECT_NE(diagnostics[0].message.find("'+'"), std::string::npos);
+    EXPECT_EQ(diagnostics[0].line, 1);
+    EXPECT_EQ(diagnostics[0].column, 11);
+}
+
+TEST(TypeInferenceTest, ReportsCallErrors) {
+    auto program = parseSource(R"(
+        func half(n) { n / 2 }
+        let a = half("ten")
+        let b = half(1, 2)
+        let c = missing(1)
+        let d = a(1)
+    )");
+
+    novasyntax::TypeInference inference;
+    auto diagnostics = inference.run(program);
+    ASSERT_EQ(diagnostics.size(), 4);
+    EXPECT_NE(diagnostics[0].message.find("Argument 1 of 'half'"), std::string::npos);
+    EXPECT_NE(diagnostics[1].message.find("expects 1 argument"), std::string::npos);
+    EXPECT_NE(diagnostics[2].message.find("Undefined function 'missing'"), std::string::npos);
+    EXPECT_NE(diagnostics[3].message.find("not a function"), std::string::npos);
+}
+
+TEST(TypeInferenceTest, GenericParametersStayUnknown) {
+    auto program = parseSource("func pick(a, b) { b }");
+
+    novasyntax::TypeInference inference;
+    EXPECT_TRUE(inference.run(program).empty());
+
+    auto* pick = dynamic_cast<novasyntax::FunctionDeclaration*>(program[0].get());
+    ASSERT_NE(pick, nullptr);
+    ASSERT_EQ(pick->parameter_types.size(), 2);
+    EXPECT_EQ(pick->parameter_types[0], novasyntax::ValueType::UNKNOWN);
+    EXPECT_EQ(pick->return_type, novasyntax::ValueType::UNKNOWN);
+}